@@ -0,0 +1,76 @@
+/*
+	File:		fuzz_chip8.cpp
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+
+	libFuzzer harness for the headless Chip8 core.
+	Build with -DCHIP8_BUILD_FUZZER=ON using clang, then run:
+		./chip8_fuzzer -max_len=4096 corpus/
+
+	Input layout:
+		byte 0				Length L of the input script (0-255)
+		bytes 1..L			Input script, one event per byte
+		bytes L+1..			ROM image, loaded at 0x200
+
+	Script byte:
+		bit 7		1 = press, 0 = release
+		bits 4-6	Run 2^n instructions before the event
+		bits 0-3	Key
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include "chip8.h"
+
+// Keeps each input short so executions per second stay high.
+const int MAX_INSTRUCTIONS = 4096;
+const int INSTRUCTIONS_PER_TIMER_TICK = 16;
+
+static void runFor(Chip8& core, int count, int& executed) {
+	for (int i = 0; i < count && executed < MAX_INSTRUCTIONS; i++, executed++) {
+		if (executed % INSTRUCTIONS_PER_TIMER_TICK == 0)
+			core.tickTimers();
+		if (core.isWaitingForKey())
+			continue;
+		core.execute();
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+	// Build the machine once, then reset it from the snapshot and
+	// copy the ROM into its pages for every input. Neither allocates.
+	static Chip8 core;
+	static Chip8Snapshot pristine;
+	static bool initialized = false;
+	if (!initialized) {
+		core.setFaultPolicy(FaultPolicy::Skip); // Keep going to reach more code
+		core.save(pristine);
+		initialized = true;
+	}
+	core.restore(pristine);
+
+	if (size == 0)
+		return 0;
+
+	size_t scriptLength = data[0];
+	if (scriptLength > size - 1)
+		scriptLength = size - 1;
+	const uint8_t* script = data + 1;
+	const uint8_t* rom = script + scriptLength;
+	size_t romSize = size - 1 - scriptLength;
+	if (romSize > C8_RAM_SIZE - C8_PROGRAM_START)
+		romSize = C8_RAM_SIZE - C8_PROGRAM_START;
+	core.loadROM(rom, romSize);
+
+	int executed = 0;
+	for (size_t i = 0; i < scriptLength; i++) {
+		uint8_t event = script[i];
+		runFor(core, 1 << ((event >> 4) & 0x7), executed);
+		if (event & 0x80)
+			core.pressKey(event & 0xF);
+		else
+			core.releaseKey(event & 0xF);
+	}
+	runFor(core, MAX_INSTRUCTIONS, executed);
+	return 0;
+}
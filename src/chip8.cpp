@@ -0,0 +1,771 @@
+/*
+	File:		chip8.cpp
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdint.h>
+#include <stdexcept>
+#include "chip8.h"
+
+
+static const uint8_t fontData[80] =
+{ 0xF0, 0x90, 0x90, 0x90, 0xF0,  // 0
+ 0x20, 0x60, 0x20, 0x20, 0x70,   // 1
+ 0xF0, 0x10, 0xF0, 0x80, 0xF0,   // 2
+ 0xF0, 0x10, 0xF0, 0x10, 0xF0,   // 3
+ 0x90, 0x90, 0xF0, 0x10, 0x10,   // 4
+ 0xF0, 0x80, 0xF0, 0x10, 0xF0,   // 5
+ 0xF0, 0x80, 0xF0, 0x90, 0xF0,   // 6
+ 0xF0, 0x10, 0x20, 0x40, 0x40,   // 7
+ 0xF0, 0x90, 0xF0, 0x90, 0xF0,   // 8
+ 0xF0, 0x90, 0xF0, 0x10, 0xF0,   // 9
+ 0xF0, 0x90, 0xF0, 0x90, 0x90,   // A
+ 0xE0, 0x90, 0xE0, 0x90, 0xE0,   // B
+ 0xF0, 0x80, 0x80, 0x80, 0xF0,   // C
+ 0xE0, 0x90, 0x90, 0x90, 0xE0,   // D
+ 0xF0, 0x80, 0xF0, 0x80, 0xF0,   // E
+ 0xF0, 0x80, 0xF0, 0x80, 0x80 }; // F
+
+// Approximate COSMAC VIP cost of each instruction in machine cycles
+// (about 4.54us each), after fetch and decode. Adapted from published
+// analyses of the VIP interpreter; the ones that depend on their
+// operands are finished off in vipCycles().
+const int VIP_FETCH_CYCLES = 40;
+static const uint8_t VIP_CYCLES[16] = {
+	24,	// 0NNN / 00E0 / 00EE
+	12,	// 1NNN
+	26,	// 2NNN
+	14,	// 3XNN
+	14,	// 4XNN
+	18,	// 5XY0
+	6,	// 6XNN
+	10,	// 7XNN
+	44,	// 8XYN
+	18,	// 9XY0
+	12,	// ANNN
+	22,	// BNNN
+	36,	// CXNN
+	26,	// DXYN, plus each row
+	18,	// EX9E / EXA1
+	10	// FXNN, see VIP_F_CYCLES
+};
+
+// FXNN by NN. Unused entries cost the same as FX07.
+static const struct VipFTable {
+	uint8_t cycles[256];
+	VipFTable() {
+		for (int i = 0; i < 256; i++)
+			cycles[i] = 10;
+		cycles[0x0A] = 18;
+		cycles[0x1E] = 19;
+		cycles[0x29] = 20;
+		cycles[0x33] = 84;	// Plus 16 per unit counted, see vipCycles()
+		cycles[0x55] = 14;	// Plus 14 per register
+		cycles[0x65] = 14;	// Plus 14 per register
+	}
+} VIP_F_CYCLES;
+
+// Font only, shared by every machine that has not loaded a ROM.
+static std::shared_ptr<const Chip8Image> blankImage() {
+	static const std::shared_ptr<const Chip8Image> blank = makeROMImage(nullptr, 0);
+	return blank;
+}
+
+std::shared_ptr<const Chip8Image> makeROMImage(const uint8_t* data, size_t size) {
+	if (size > C8_RAM_SIZE - C8_PROGRAM_START)
+		throw std::runtime_error("ROM is too large to store in RAM.");
+	std::shared_ptr<Chip8Image> image = std::make_shared<Chip8Image>();
+	memset(image->RAM, 0, sizeof(image->RAM));
+	memcpy(&image->RAM[0], fontData, sizeof(fontData));
+	if (size > 0)
+		memcpy(&image->RAM[C8_PROGRAM_START], data, size);
+	return image;
+}
+
+Chip8PageArena::Chip8PageArena(int pages) {
+	if (pages < 1 || pages > MAX_PAGES)
+		throw std::runtime_error("RAM page arena size out of range.");
+	pageCount = pages;
+	storage.reset(new uint8_t[static_cast<size_t>(pageCount) * C8_PAGE_SIZE]); // Left untouched
+	freeSlots.reset(new uint16_t[pageCount]);
+}
+
+bool Chip8PageArena::acquire(uint16_t* slots, int count) noexcept {
+	while (lock.test_and_set(std::memory_order_acquire))
+		;
+	bool found = freeCount + (pageCount - nextFresh) >= count;
+	for (int i = 0; found && i < count; i++) {
+		if (freeCount > 0)
+			slots[i] = freeSlots[--freeCount];
+		else
+			slots[i] = static_cast<uint16_t>(nextFresh++);
+	}
+	lock.clear(std::memory_order_release);
+	return found;
+}
+
+void Chip8PageArena::release(const uint16_t* slots, int count) noexcept {
+	while (lock.test_and_set(std::memory_order_acquire))
+		;
+	for (int i = 0; i < count; i++)
+		freeSlots[freeCount++] = slots[i];
+	lock.clear(std::memory_order_release);
+}
+
+int Chip8PageArena::pagesInUse() const {
+	while (lock.test_and_set(std::memory_order_acquire))
+		;
+	int inUse = nextFresh - freeCount;
+	lock.clear(std::memory_order_release);
+	return inUse;
+}
+
+// As many machines as slots can number. Untouched pages cost
+// address space only, so a handful of machines commit a few pages.
+Chip8PageArena& defaultPageArena() {
+	static Chip8PageArena arena(Chip8PageArena::MAX_PAGES);
+	return arena;
+}
+
+Chip8::OwnedPages::OwnedPages(Chip8PageArena& from) : arena(&from) {
+	if (!arena->acquire(slot, C8_PAGE_COUNT))
+		throw std::runtime_error("Out of RAM pages for another machine.");
+}
+
+Chip8::OwnedPages::OwnedPages(OwnedPages&& other) noexcept : arena(other.arena), touched(other.touched) {
+	memcpy(slot, other.slot, sizeof(slot));
+	other.arena = nullptr;
+}
+
+Chip8::OwnedPages& Chip8::OwnedPages::operator=(OwnedPages&& other) noexcept {
+	if (this != &other) {
+		releaseAll();
+		arena = other.arena;
+		touched = other.touched;
+		memcpy(slot, other.slot, sizeof(slot));
+		other.arena = nullptr;
+	}
+	return *this;
+}
+
+Chip8::OwnedPages::~OwnedPages() {
+	releaseAll();
+}
+
+void Chip8::OwnedPages::releaseAll() noexcept {
+	if (arena)
+		arena->release(slot, C8_PAGE_COUNT);
+	arena = nullptr;
+	touched = 0;
+}
+
+Chip8::Chip8() : Chip8(defaultPageArena()) {}
+
+Chip8::Chip8(Chip8PageArena& arena) : owned(arena) {
+	memset(&machine, 0, sizeof(machine));
+	machine.PC = C8_PROGRAM_START;
+	machine.randState = 0x2545F491;
+	shiftVY = false;
+	resetVF = false;
+	incrementOnlyByX = false;
+	incrementNone = false;
+	displayWait = false;
+	fault = Chip8Fault();
+	faultPolicy = FaultPolicy::Halt;
+	keyReads = 0;
+	draws = 0;
+	presentedHash = 0;
+	loadImage(blankImage());
+}
+
+std::vector<uint8_t> readROMFile(const std::string& PathToROM) {
+	std::ifstream inFile(PathToROM, std::ios::binary);
+	if (!inFile.is_open())
+		throw std::runtime_error("Unable to open ROM. Double check the file path.");
+
+	inFile.seekg(0, inFile.end);
+	std::streamsize inFileSize = inFile.tellg();
+	inFile.seekg(0, inFile.beg);
+
+	if (inFileSize < 0)
+		throw std::runtime_error("Unable to read file size.");
+	else if (inFileSize + C8_PROGRAM_START > C8_RAM_SIZE)
+		throw std::runtime_error("ROM is too large to store in RAM.");
+
+	std::vector<uint8_t> rom(static_cast<size_t>(inFileSize));
+	if (!inFile.read(reinterpret_cast<char*>(rom.data()), inFileSize))
+		throw std::runtime_error("Unable to open ROM");
+	return rom;
+}
+
+// The font comes from the blank image, and only the pages the ROM
+// covers are copied in, so nothing is allocated.
+void Chip8::loadROM(const uint8_t* data, size_t size) {
+	if (size > C8_RAM_SIZE - C8_PROGRAM_START)
+		throw std::runtime_error("ROM is too large to store in RAM.");
+	loadImage(blankImage());
+	if (size == 0)
+		return;
+	makeWritable(C8_PROGRAM_START, static_cast<int>(size));
+	for (size_t done = 0; done < size; done += C8_PAGE_SIZE) {
+		int page = (C8_PROGRAM_START + static_cast<int>(done)) / C8_PAGE_SIZE; // 0x200 starts a page
+		memcpy(owned.arena->page(owned.slot[page]), data + done, std::min<size_t>(size - done, C8_PAGE_SIZE));
+	}
+}
+
+// Every page goes back to reading from the image.
+void Chip8::loadImage(std::shared_ptr<const Chip8Image> newImage) {
+	image = std::move(newImage);
+	machine.privatePages = 0;
+}
+
+// Copy on write: before the first write to a shared page, copy it
+// into this machine's arena page. Covers every page in
+// [addr, addr + length), wrapping at 4K.
+void Chip8::makeWritable(uint16_t addr, int length) {
+	int first = (addr >> 8) & 0xF;
+	int last = ((addr + length - 1) >> 8) & 0xF;
+	for (int page = first; ; page = (page + 1) & 0xF) {
+		if (!((machine.privatePages >> page) & 1u)) {
+			memcpy(owned.arena->page(owned.slot[page]), &image->RAM[page * C8_PAGE_SIZE], C8_PAGE_SIZE);
+			machine.privatePages |= 1u << page;
+			owned.touched |= 1u << page;
+		}
+		if (page == last)
+			return;
+	}
+}
+
+int Chip8::privatePageCount() const {
+	int count = 0;
+	for (uint16_t mask = machine.privatePages; mask; mask &= mask - 1)
+		count++;
+	return count;
+}
+
+int Chip8::committedPageCount() const {
+	int count = 0;
+	for (uint16_t mask = owned.touched; mask; mask &= mask - 1)
+		count++;
+	return count;
+}
+
+Chip8Status Chip8::execute() {
+	if (machine.halted)
+		return Chip8Status::Halted;
+	if (machine.waitingForVblank)
+		return Chip8Status::Ok;
+
+	// Useful parts of instruction
+	// Addresses wrap at 4K, so a PC of 0xFFF reads its second byte from 0x000.
+	uint8_t leftByte = readRAM(machine.PC);
+	uint8_t rightByte = readRAM(machine.PC + 1);
+	uint16_t bothByte = ((uint16_t) leftByte << 8) | rightByte;
+	uint8_t firstNib = leftByte >> 4; // Leftmost
+	uint8_t secondNib = leftByte & 0xf;
+	uint8_t thirdNib = rightByte >> 4;
+	uint8_t fourthNib = rightByte & 0xf; // Rightmost
+	machine.PC = (machine.PC + 2) & C8_ADDR_MASK;
+	Chip8Status status = Chip8Status::Ok;
+
+	switch (firstNib)
+	{
+	case 0:
+		if (leftByte == 0x00 && rightByte == 0xEE)
+			status = returnFunc();
+		else if (leftByte == 0x00 && rightByte == 0xE0)
+			clearDisplay();
+		else
+			status = callFunc(0xCAFE); // Instruction Ignored
+		break;
+	case 1:
+		jump(bothByte & 0x0FFF);
+		break;
+	case 2:
+		status = callFuncAt(bothByte & 0x0FFF);
+		break;
+	case 3:
+		skipEq(secondNib, rightByte);
+		break;
+	case 4:
+		skipNeq(secondNib, rightByte);
+		break;
+	case 5:
+		skipRegEq(secondNib, thirdNib);
+		break;
+	case 6:
+		setRegX(secondNib, rightByte);
+		break;
+	case 7:
+		addRegX(secondNib, rightByte);
+		break;
+	case 8:
+		switch (fourthNib) {
+		case 0x0:
+			setRegXY(secondNib, thirdNib);
+			break;
+		case 0x1:
+			regOr(secondNib, thirdNib);
+			break;
+		case 0x2:
+			regAnd(secondNib, thirdNib);
+			break;
+		case 0x3:
+			regXor(secondNib, thirdNib);
+			break;
+		case 0x4:
+			addRegXY(secondNib, thirdNib);
+			break;
+		case 0x5:
+			subRegXY(secondNib, thirdNib);
+			break;
+		case 0x6:
+			shrRegXY(secondNib, thirdNib);
+			break;
+		case 0x7:
+			subRegYX(secondNib, thirdNib);
+			break;
+		case 0xE:
+			shlRegXY(secondNib, thirdNib);
+			break;
+		default:
+			status = Chip8Status::UnknownOpcode;
+			break;
+		}
+		break;
+	case 9:
+		if (fourthNib == 0x0)
+			skipRegNeq(secondNib, thirdNib);
+		else
+			status = Chip8Status::UnknownOpcode;
+		break;
+	case 0xA:
+		setI(bothByte & 0x0FFF);
+		break;
+	case 0xB:
+		jumpPlus(bothByte & 0x0FFF);
+		break;
+	case 0xC:
+		setXRand(secondNib, rightByte);
+		break;
+	case 0xD:
+		draw(secondNib, thirdNib, fourthNib);
+		break;
+	case 0xE:
+		if (rightByte == 0x9E)
+			skipKeyEq(secondNib);
+		else if (rightByte == 0xA1)
+			skipKeyNeq(secondNib);
+		else
+			status = Chip8Status::UnknownOpcode;
+		break;
+	case 0xF:
+		switch (rightByte)
+		{
+		case 0x07:
+			setXDelay(secondNib);
+			break;
+		case 0x0A:
+			waitForKey(secondNib);
+			break;
+		case 0x15:
+			setDelayX(secondNib);
+			break;
+		case 0x18:
+			setSoundX(secondNib);
+			break;
+		case 0x1E:
+			addXI(secondNib);
+			break;
+		case 0x29:
+			setISprite(secondNib);
+			break;
+		case 0x33:
+			setIBCD(secondNib);
+			break;
+		case 0x55:
+			regDump(secondNib);
+			break;
+		case 0x65:
+			regLoad(secondNib);
+			break;
+		default:
+			status = Chip8Status::UnknownOpcode;
+			break;
+		}
+		break;
+	default:
+		status = Chip8Status::UnknownOpcode;
+		break;
+	}
+
+	if (status != Chip8Status::Ok) {
+		fault.status = status;
+		fault.opcode = bothByte;
+		fault.PC = (machine.PC - 2) & C8_ADDR_MASK;
+		if (isFault(status) && faultPolicy == FaultPolicy::Halt)
+			machine.halted = true;
+	}
+	return status;
+}
+
+void Chip8::tickTimers() {
+	if (machine.delayTimer > 0) machine.delayTimer--;
+	if (machine.soundTimer > 0) machine.soundTimer--;
+	machine.waitingForVblank = false;
+}
+
+Chip8Status Chip8::runFrame(int instructions) {
+	Chip8Status worst = Chip8Status::Ok;
+	for (int i = 0; i < instructions && !machine.waitingForKey && !machine.halted && !machine.waitingForVblank; i++) {
+		Chip8Status status = execute();
+		if (status > worst)
+			worst = status;
+		if (isFault(status) && faultPolicy == FaultPolicy::Break)
+			break;
+	}
+	tickTimers();
+	return worst;
+}
+
+Chip8Status Chip8::runVipFrame() {
+	Chip8Status worst = Chip8Status::Ok;
+	machine.cycleBudget += VIP_CYCLES_PER_FRAME - VIP_DISPLAY_CYCLES;
+	while (machine.cycleBudget > 0) {
+		if (machine.waitingForKey || machine.halted || machine.waitingForVblank) {
+			machine.cycleBudget = 0; // Idle until the next frame
+			break;
+		}
+		uint16_t opcode = (readRAM(machine.PC) << 8) | readRAM(machine.PC + 1);
+		machine.cycleBudget -= vipCycles(opcode);
+		Chip8Status status = execute();
+		if (status > worst)
+			worst = status;
+		if (isFault(status) && faultPolicy == FaultPolicy::Break)
+			break;
+	}
+	tickTimers();
+	return worst;
+}
+
+int Chip8::vipCycles(uint16_t opcode) const {
+	uint8_t firstNib = opcode >> 12;
+	uint8_t X = (opcode >> 8) & 0xF;
+	int cycles = VIP_FETCH_CYCLES + VIP_CYCLES[firstNib];
+	if (firstNib == 0xD) {
+		// Each row is XORed into one display byte, or two shifted
+		// halves when the sprite does not start on a byte boundary.
+		int N = opcode & 0xF;
+		int shift = machine.V[X] % 8;
+		cycles += N * (shift == 0 ? 22 : 34 + 2 * shift);
+	}
+	else if (firstNib == 0xF) {
+		uint8_t NN = opcode & 0xFF;
+		cycles += VIP_F_CYCLES.cycles[NN] - VIP_CYCLES[0xF];
+		if (NN == 0x33) {
+			uint8_t num = machine.V[X];
+			cycles += 16 * (num / 100 + (num / 10) % 10 + num % 10);
+		}
+		else if (NN == 0x55 || NN == 0x65) {
+			cycles += 14 * (X + 1);
+		}
+	}
+	return cycles;
+}
+
+void Chip8::pressKey(uint8_t key) {
+	machine.keys |= (1u << (key & 0xF));
+}
+
+void Chip8::releaseKey(uint8_t key) {
+	machine.keys &= ~(1u << (key & 0xF));
+	if (machine.waitingForKey) { // FX0A Functionality
+		machine.waitingForKey = false;
+		machine.V[machine.waitingRegister] = key & 0xF;
+		keyReads++;
+	}
+}
+
+void Chip8::setKeys(uint16_t keys) {
+	uint16_t released = machine.keys & ~keys;
+	machine.keys = keys;
+	if (machine.waitingForKey && released) { // FX0A Functionality
+		uint8_t key = 0;
+		while (!((released >> key) & 1u))
+			key++;
+		machine.waitingForKey = false;
+		machine.V[machine.waitingRegister] = key;
+		keyReads++;
+	}
+}
+
+bool Chip8::takeScreenUpdate() {
+	bool updated = machine.screenUpdated;
+	machine.screenUpdated = false;
+	return updated;
+}
+
+void Chip8::save(Chip8Snapshot& snapshot) const {
+	memcpy(&snapshot.state, &machine, sizeof(machine));
+	snapshot.image = image;
+	for (int p = 0; p < C8_PAGE_COUNT; p++) {
+		if ((machine.privatePages >> p) & 1u)
+			memcpy(snapshot.pages[p], pageData(p), C8_PAGE_SIZE);
+	}
+}
+
+void Chip8::restore(const Chip8Snapshot& snapshot) {
+	uint16_t written = snapshot.state.privatePages;
+	if (image != snapshot.image)
+		image = snapshot.image;
+	memcpy(&machine, &snapshot.state, sizeof(machine));
+	for (int p = 0; p < C8_PAGE_COUNT; p++) {
+		if ((written >> p) & 1u)
+			memcpy(owned.arena->page(owned.slot[p]), snapshot.pages[p], C8_PAGE_SIZE);
+	}
+	owned.touched |= written;
+}
+
+uint16_t Chip8::sprite_addr(uint8_t hex) const {
+	return hex * 5;
+}
+
+// xorshift32. Lives in the machine state so a restored
+// snapshot replays the same "random" numbers.
+uint8_t Chip8::nextRandom() {
+	uint32_t x = machine.randState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	machine.randState = x;
+	return x >> 24;
+}
+
+////////////////////////////////
+/*	        OPCODES          */
+//////////////////////////////
+
+Chip8Status Chip8::callFunc(uint16_t NNN) {
+	return Chip8Status::IgnoredCall;
+}
+
+
+void Chip8::clearDisplay() {
+	memset(machine.screen, 0, sizeof(machine.screen));
+	machine.frameHash = 0;
+	machine.screenUpdated = true;
+}
+
+Chip8Status Chip8::returnFunc() {
+	if (machine.SP == 0)
+		return Chip8Status::StackUnderflow;
+	machine.PC = machine.Stack[--machine.SP];
+	return Chip8Status::Ok;
+}
+
+void Chip8::jump(uint16_t NNN) { machine.PC = NNN; }
+
+Chip8Status Chip8::callFuncAt(uint16_t NNN) {
+	if (machine.SP == C8_STACK_SIZE)
+		return Chip8Status::StackOverflow;
+	machine.Stack[machine.SP++] = machine.PC;
+	machine.PC = NNN;
+	return Chip8Status::Ok;
+}
+
+void Chip8::skipEq(uint16_t X, uint16_t NN) {
+	if (machine.V[X] == NN)
+		machine.PC += 2;
+}
+
+void Chip8::skipNeq(uint16_t X, uint16_t NN) {
+	if (machine.V[X] != NN)
+		machine.PC += 2;
+}
+
+void Chip8::skipRegEq(uint16_t X, uint16_t Y) {
+	if (machine.V[X] == machine.V[Y])
+		machine.PC += 2;
+}
+
+void Chip8::setRegX(uint16_t X, uint16_t NN) { machine.V[X] = NN; }
+
+void Chip8::addRegX(uint16_t X, uint16_t NN) { machine.V[X] += NN; }
+
+void Chip8::setRegXY(uint16_t X, uint16_t Y) { machine.V[X] = machine.V[Y]; }
+
+void Chip8::regOr(uint16_t X, uint16_t Y) {
+	machine.V[X] |= machine.V[Y];
+	if (resetVF)
+		machine.V[0xF] = 0; // QUIRK 5
+}
+void Chip8::regAnd(uint16_t X, uint16_t Y) {
+	machine.V[X] &= machine.V[Y];
+	if (resetVF)
+		machine.V[0xF] = 0; // QUIRK 5
+}
+
+void Chip8::regXor(uint16_t X, uint16_t Y) {
+	machine.V[X] ^= machine.V[Y];
+
+	if (resetVF)
+		machine.V[0xF] = 0; // QUIRK 5
+}
+
+void Chip8::addRegXY(uint16_t X, uint16_t Y) {
+	uint16_t sum = machine.V[X] + machine.V[Y]; // Ensure flag stays set if X = F.
+	machine.V[X] += machine.V[Y];
+	machine.V[0xF] = (sum > UINT8_MAX) ? 1 : 0;
+}
+
+void Chip8::subRegXY(uint16_t X, uint16_t Y) {
+	uint8_t origX = machine.V[X];
+	uint8_t origY = machine.V[Y];
+	machine.V[X] = origX - origY;
+	if (origX >= origY)
+		machine.V[0xF] = 1; // No Underflow
+	else
+		machine.V[0xF] = 0; // Underflow
+}
+
+void Chip8::shrRegXY(uint16_t X, uint16_t Y) {
+	if (shiftVY) { // Quirk 6
+		machine.V[X] = machine.V[Y] >> 1;
+		machine.V[0xF] = machine.V[Y] & 1u;
+	}
+	else {
+		uint8_t bit = machine.V[X] & 1u; // Ensure flag stays set if X = F.
+		machine.V[X] >>= 1;
+		machine.V[0xF] = bit;
+	}
+}
+
+
+void Chip8::subRegYX(uint16_t X, uint16_t Y) {
+	uint8_t origX = machine.V[X];
+	uint8_t origY = machine.V[Y];
+	machine.V[X] = origY - origX;
+	if (origY >= origX)
+		machine.V[0xF] = 1; // Underflow
+	else
+		machine.V[0xF] = 0; // No underflow
+}
+
+void Chip8::shlRegXY(uint16_t X, uint16_t Y) {
+	if (shiftVY) { // Quirk 6
+		machine.V[X] = machine.V[Y] << 1;
+		machine.V[0xF] = (machine.V[Y] & (1u << 7)) >> 7;
+	}
+	else {
+		uint8_t bit = (machine.V[X] & (1u << 7)) >> 7; // Ensure flag stays set if X = F.
+		machine.V[X] <<= 1;
+		machine.V[0xF] = bit;
+	}
+}
+
+void Chip8::skipRegNeq(uint16_t X, uint16_t Y) {
+	if (machine.V[X] != machine.V[Y])
+		machine.PC += 2;
+}
+
+void Chip8::setI(uint16_t NNN) { machine.I = NNN; }
+
+void Chip8::jumpPlus(uint16_t NNN) { machine.PC = (machine.V[0] + NNN) & C8_ADDR_MASK; }
+
+void Chip8::setXRand(uint16_t X, uint16_t NN) { machine.V[X] = nextRandom() & NN; }
+
+void Chip8::draw(uint16_t X, uint16_t Y, uint16_t N) {
+	uint8_t xOrig = machine.V[X] % C8_WIDTH;
+	uint8_t yOrig = machine.V[Y] % C8_HEIGHT;
+	machine.V[0xf] = 0;
+	for (int i = 0; i < N; i++) {
+		if (yOrig + i >= C8_HEIGHT) // Clipping
+			break;
+
+		// Line the sprite row up with the screen row. Columns past
+		// the right edge fall off the end of the word (Clipping).
+		uint8_t row = readRAM(machine.I + i);
+		uint64_t bits = ((uint64_t) row << 56) >> xOrig;
+		if (bits == 0) // Nothing on screen to flip
+			continue;
+		uint64_t& screenRow = machine.screen[yOrig + i];
+		if (screenRow & bits) // Flip Check
+			machine.V[0xf] = 1;
+		machine.frameHash ^= screenRowHash(yOrig + i, screenRow) ^ screenRowHash(yOrig + i, screenRow ^ bits);
+		screenRow ^= bits;
+	}
+
+	machine.screenUpdated = true;
+	draws++;
+	if (displayWait)
+		machine.waitingForVblank = true;
+}
+
+// Keys above F do not exist, so neither skip fires for them.
+void Chip8::skipKeyEq(uint16_t X) {
+	uint8_t keyNum = machine.V[X];
+	keyReads++;
+	if (keyNum < 16 && (machine.keys >> keyNum) & 1u)
+		machine.PC += 2;
+}
+
+void Chip8::skipKeyNeq(uint16_t X) {
+	uint8_t keyNum = machine.V[X];
+	keyReads++;
+	if (keyNum < 16 && !((machine.keys >> keyNum) & 1u))
+		machine.PC += 2;
+}
+
+void Chip8::setXDelay(uint16_t X) { machine.V[X] = machine.delayTimer; }
+
+void Chip8::waitForKey(uint16_t X) {
+	machine.waitingForKey = true;
+	machine.waitingRegister = X;
+}
+
+void Chip8::setDelayX(uint16_t X) { machine.delayTimer = machine.V[X]; }
+
+void Chip8::setSoundX(uint16_t X) { machine.soundTimer = machine.V[X]; }
+
+void Chip8::addXI(uint16_t X) { machine.I += machine.V[X]; }
+
+void Chip8::setISprite(uint16_t X) { machine.I = sprite_addr(machine.V[X]); }
+
+void Chip8::setIBCD(uint16_t X) {
+	makeWritable(machine.I, 3);
+	uint8_t num = machine.V[X];
+	writeRAM(machine.I, num / 100);
+	writeRAM(machine.I + 1, (num / 10) % 10);
+	writeRAM(machine.I + 2, num % 10);
+}
+
+void Chip8::regDump(uint16_t X) {
+	makeWritable(machine.I, X + 1);
+	for (uint8_t i = 0; i <= X; i++) {
+		writeRAM(machine.I + i, machine.V[i]);
+	}
+
+	if (incrementOnlyByX) // Quirk 12
+		machine.I += X;
+	else if (incrementNone) // Quirk 12
+		;
+	else
+		machine.I += X + 1;
+}
+
+void Chip8::regLoad(uint16_t X) {
+	for (uint8_t i = 0; i <= X; i++) {
+		machine.V[i] = readRAM(machine.I + i);
+	}
+
+	if (incrementOnlyByX) // Quirk 12
+		machine.I += X;
+	else if (incrementNone) // Quirk 12
+		;
+	else
+		machine.I += X + 1;
+}
@@ -0,0 +1,433 @@
+/*
+	File:		chip8.h
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+#pragma once
+#ifndef CHIP8_H
+#define CHIP8_H
+
+#include <cstddef>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+const int C8_WIDTH = 64;
+const int C8_HEIGHT = 32;
+const int C8_RAM_SIZE = 4096;
+const int C8_STACK_SIZE = 16;
+const uint16_t C8_ADDR_MASK = 0x0FFF;
+const uint16_t C8_PROGRAM_START = 0x200;
+
+// RAM is split into pages that are shared with every machine
+// running the same ROM until the machine writes to them.
+const int C8_PAGE_SIZE = 256;
+const int C8_PAGE_COUNT = C8_RAM_SIZE / C8_PAGE_SIZE;
+
+// Length of one 60Hz frame, and the instructions a 1000Hz
+// machine runs in it.
+const double SIXTY_HZ_MS = 16.67;
+const int C8_INSTRUCTIONS_PER_FRAME = 17;
+
+// COSMAC VIP: 1.7609 MHz, 8 clocks per machine cycle, 60 frames per second.
+// The 1861 display DMA takes 128 lines x 8 bytes of every frame.
+const int VIP_CYCLES_PER_FRAME = 3668;
+const int VIP_DISPLAY_CYCLES = 1024;
+
+// Result of executing an instruction, worst last.
+enum class Chip8Status : uint8_t {
+	Ok,
+	IgnoredCall,	// 0NNN, skipped as usual
+	Halted,			// Machine stopped by an earlier fault
+	StackUnderflow,	// 00EE with nothing to return to
+	StackOverflow,	// 2NNN with all 16 levels in use
+	UnknownOpcode
+};
+
+inline bool isFault(Chip8Status status) { return status >= Chip8Status::StackUnderflow; }
+
+// What the machine does when an instruction faults.
+// Nothing here ever waits on the user.
+enum class FaultPolicy : uint8_t {
+	Halt,	// Stop the machine until it is restored
+	Skip,	// Treat the instruction as a no-op and carry on
+	Break	// Stop the current frame so the host can trap into a debugger
+};
+
+// The last instruction that did not return Ok.
+struct Chip8Fault {
+	Chip8Status status;
+	uint16_t opcode;
+	uint16_t PC;
+};
+
+// Everything that makes up a running machine, apart from RAM.
+// Kept trivially copyable so it can be saved and restored with
+// a single memcpy.
+struct Chip8State {
+	uint8_t V[16];
+	uint64_t screen[C8_HEIGHT]; // One bit per pixel, bit 63 is the leftmost column
+	uint64_t frameHash; // XOR of screenRowHash over every row, kept up to date by 00E0 and DXYN
+	uint16_t Stack[C8_STACK_SIZE];
+	uint8_t SP;
+	uint16_t PC;
+	uint16_t I;
+	uint8_t delayTimer;
+	uint8_t soundTimer;
+	uint16_t keys; // Bit N is set while key N is held down
+	uint8_t waitingRegister;
+	bool waitingForKey;
+	bool screenUpdated;
+	bool halted;
+	bool waitingForVblank; // Display wait quirk: DXYN sleeps until the next timer tick
+	int32_t cycleBudget; // COSMAC VIP timing: machine cycles left in this frame
+	uint32_t randState;
+	uint16_t privatePages; // Bit N is set once page N has been written and has its own copy
+};
+
+static_assert(std::is_trivially_copyable<Chip8State>::value,
+	"Chip8State must stay trivially copyable for snapshot resets.");
+
+// Hash of one screen row's contents at row y. Blank rows hash to 0,
+// so a clear screen has a frame hash of 0.
+inline uint64_t screenRowHash(int y, uint64_t bits) {
+	if (bits == 0)
+		return 0;
+	uint64_t h = bits + (static_cast<uint64_t>(y) + 1) * 0x9E3779B97F4A7C15ull; // splitmix64
+	h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+	h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+	return h ^ (h >> 31);
+}
+
+// Initial contents of RAM: the font, then the ROM at 0x200.
+// Never changes once built, so any number of machines can share one.
+struct Chip8Image {
+	uint8_t RAM[C8_RAM_SIZE];
+};
+
+// Build a shareable image of the font and a ROM.
+// Throws if the ROM does not fit.
+std::shared_ptr<const Chip8Image> makeROMImage(const uint8_t* data, size_t size);
+
+// Where machines get the RAM pages they write to. Every machine takes
+// one page per RAM page when it is built, so a running machine never
+// needs another. Reserved pages are not touched until used, so the OS
+// only commits the ones machines actually write to. Safe to share
+// between threads.
+class Chip8PageArena {
+public:
+	static const int MAX_PAGES = 65536; // Slots are 16 bit
+	static const int MAX_MACHINES = MAX_PAGES / C8_PAGE_COUNT;
+
+	// Reserve room for 'pages' pages. Throws unless 1 <= pages <= MAX_PAGES.
+	explicit Chip8PageArena(int pages);
+
+	// Take 'count' pages, or none when fewer are left.
+	bool acquire(uint16_t* slots, int count) noexcept;
+	void release(const uint16_t* slots, int count) noexcept;
+
+	uint8_t* page(uint16_t slot) const { return storage.get() + slot * C8_PAGE_SIZE; }
+
+	int capacity() const { return pageCount; }
+	int pagesInUse() const;
+
+private:
+	std::unique_ptr<uint8_t[]> storage;
+	std::unique_ptr<uint16_t[]> freeSlots; // Released slots, reused first
+	int pageCount;
+	int freeCount = 0;
+	int nextFresh = 0; // Slots from here on have never been handed out
+	mutable std::atomic_flag lock = ATOMIC_FLAG_INIT;
+};
+
+// Shared by machines that are not given an arena of their own.
+Chip8PageArena& defaultPageArena();
+
+// A saved machine: its state, the image it was running, and a copy
+// of only the pages it had written to.
+struct Chip8Snapshot {
+	Chip8State state;
+	std::shared_ptr<const Chip8Image> image;
+	uint8_t pages[C8_PAGE_COUNT][C8_PAGE_SIZE]; // Valid for the pages set in state.privatePages
+};
+
+// Read a ROM file into memory, ready for Chip8::loadROM.
+// Throws if the file cannot be read or does not fit in RAM.
+std::vector<uint8_t> readROMFile(const std::string& PathToROM);
+
+// The CHIP-8 machine itself, with no window, renderer or clock.
+// Emulator drives one of these in real time; headless tools
+// (such as the fuzzer) can drive it directly.
+class Chip8 {
+public:
+	// Power on: clear memory and load the font. Pages the machine
+	// writes to come from 'arena', which must outlive it. Throws if
+	// the arena has no room for another machine.
+	Chip8();
+	explicit Chip8(Chip8PageArena& arena);
+
+	// Replace RAM with the font and a ROM at 0x200, copied into this
+	// machine's own pages. Never allocates, so a harness can load a
+	// new ROM for every run. Throws if the ROM does not fit.
+	void loadROM(const uint8_t* data, size_t size);
+
+	// Replace RAM with a shared image (see makeROMImage). Machines
+	// loaded from the same image only keep the pages they write to.
+	void loadImage(std::shared_ptr<const Chip8Image> image);
+
+	// OPCODE Decision Tree
+	// Fetch and Execute One (1) Instruction
+	// Never throws, allocates or prints. Faults are reported
+	// through the return value and handled by the fault policy.
+	Chip8Status execute();
+
+	// Count both timers down by one (call at 60Hz).
+	void tickTimers();
+
+	// Run one 60Hz frame: up to 'instructions' instructions
+	// (fewer if FX0A starts waiting or the machine halts), then
+	// one timer tick. Returns the worst status seen.
+	Chip8Status runFrame(int instructions);
+
+	// Run one 60Hz frame on the COSMAC VIP clock: instructions are
+	// charged their original cost in machine cycles until the
+	// frame's cycles run out, then timers tick. Overshoot is carried
+	// into the next frame. Pure integer arithmetic, no clock reads.
+	Chip8Status runVipFrame();
+
+	// Approximate COSMAC VIP cost of an instruction in machine cycles,
+	// given the current registers (DXYN, FX33 and FX55/65 vary).
+	int vipCycles(uint16_t opcode) const;
+
+	// Keypad input. Releasing a key completes a pending FX0A.
+	void pressKey(uint8_t key);
+	void releaseKey(uint8_t key);
+
+	// Replace the whole keypad at once (bit N = key N held).
+	// Any key that goes up completes a pending FX0A.
+	void setKeys(uint16_t keys);
+
+	// Returns whether the pixel at column x, row y is lit.
+	bool pixel(int x, int y) const { return (machine.screen[y] >> (63 - x)) & 1u; }
+
+	bool isWaitingForKey() const { return machine.waitingForKey; }
+	bool isHalted() const { return machine.halted; }
+
+	// Stop the machine the way the Halt policy does, until it is restored.
+	void halt() { machine.halted = true; }
+	bool isWaitingForVblank() const { return machine.waitingForVblank; }
+
+	const Chip8Fault& lastFault() const { return fault; }
+
+	// Returns true once after 00E0 or DXYN touched the screen.
+	bool takeScreenUpdate();
+
+	// Hash of the whole screen. Equal screens have equal hashes, so
+	// frames can be compared or deduplicated without looking at pixels.
+	// Kept up to date by DXYN (only the rows it touches) and 00E0.
+	uint64_t frameHash() const { return machine.frameHash; }
+
+	// Whether the screen differs from when markPresented() was last
+	// called. Unlike takeScreenUpdate(), a sprite drawn and then erased
+	// again in between does not count as a change.
+	bool changedSincePresent() const { return machine.frameHash != presentedHash; }
+	void markPresented() { presentedHash = machine.frameHash; }
+
+	// Running counts of instructions that read the keypad (EX9E, EXA1
+	// and FX0A completing) and of DXYNs. Compare them before and after
+	// a batch to see whether input was observed or the screen drawn.
+	uint32_t keyReadCount() const { return keyReads; }
+	uint32_t drawCount() const { return draws; }
+
+	const Chip8State& state() const { return machine; }
+
+	// Read one byte of RAM (the address wraps at 4K).
+	uint8_t readRAM(uint16_t addr) const { return pageData((addr >> 8) & 0xF)[addr & 0xFF]; }
+
+	// Page ownership: how many pages this machine has its own copy of,
+	// how many it still shares with the image, how many of its arena
+	// pages it has ever written to (and the OS has committed), and how
+	// many machines and snapshots share its image.
+	int privatePageCount() const;
+	int sharedPageCount() const { return C8_PAGE_COUNT - privatePageCount(); }
+	int committedPageCount() const;
+	long imageUsers() const { return image.use_count(); }
+
+	// Bytes this machine keeps to itself, committed arena pages included.
+	size_t residentBytes() const { return sizeof(Chip8) + committedPageCount() * C8_PAGE_SIZE; }
+
+	// Snapshot support. Only written pages are copied, and restoring
+	// copies them into this machine's arena pages, so resetting to a
+	// pristine snapshot is a memcpy of the state.
+	void save(Chip8Snapshot& snapshot) const;
+	void restore(const Chip8Snapshot& snapshot);
+
+	// https://chip8.gulrak.net/#quirk5
+	void setBitwiseQuirk(bool setting) { resetVF = setting; }
+
+	// https://chip8.gulrak.net/#quirk6
+	void setShiftQuirk(bool setting) { shiftVY = setting; }
+
+	// The original interpreter waits for the display interrupt before
+	// drawing, so at most one DXYN runs per frame.
+	// https://chip8.gulrak.net/
+	void setDisplayWaitQuirk(bool setting) { displayWait = setting; }
+
+	void setFaultPolicy(FaultPolicy policy) { faultPolicy = policy; }
+
+private:
+	// One arena page per RAM page, taken when the machine is built.
+	// Given back when the machine goes away; moving a machine moves
+	// them with it.
+	struct OwnedPages {
+		Chip8PageArena* arena; // Null once moved from
+		uint16_t touched = 0; // Bit N is set once slot[N] has been written to
+		uint16_t slot[C8_PAGE_COUNT];
+
+		explicit OwnedPages(Chip8PageArena& from); // Throws if the arena is full
+		OwnedPages(OwnedPages&& other) noexcept;
+		OwnedPages& operator=(OwnedPages&& other) noexcept;
+		~OwnedPages();
+		void releaseAll() noexcept;
+	};
+
+	Chip8State machine;
+	std::shared_ptr<const Chip8Image> image;
+	OwnedPages owned;
+	Chip8Fault fault;
+	FaultPolicy faultPolicy;
+	uint32_t keyReads;
+	uint32_t draws;
+	uint64_t presentedHash;
+
+	/* Quirk Toggles */
+	bool shiftVY;
+	bool resetVF;
+	bool incrementOnlyByX;
+	bool incrementNone;
+	bool displayWait;
+
+	/* Helper Functions */
+	uint16_t sprite_addr(uint8_t hex) const;
+	uint8_t nextRandom();
+	// Private pages live in the arena, the rest are read from the image.
+	const uint8_t* pageData(int page) const {
+		return ((machine.privatePages >> page) & 1u) ? owned.arena->page(owned.slot[page]) : &image->RAM[page * C8_PAGE_SIZE];
+	}
+	void makeWritable(uint16_t addr, int length);
+	void writeRAM(uint16_t addr, uint8_t value) { owned.arena->page(owned.slot[(addr >> 8) & 0xF])[addr & 0xFF] = value; }
+
+	////////////////////////////////
+	/*	        OPCODES          */
+	//////////////////////////////
+
+	// 0NNN
+	Chip8Status callFunc(uint16_t NNN);
+
+	// 00E0
+	void clearDisplay();
+
+	// 00EE
+	Chip8Status returnFunc();
+
+	// 1NNN
+	void jump(uint16_t NNN);
+
+	// 2NNN
+	Chip8Status callFuncAt(uint16_t NNN);
+
+	// 3XNN
+	void skipEq(uint16_t X, uint16_t NN);
+
+	// 4XNN
+	void skipNeq(uint16_t X, uint16_t NN);
+
+	// 5XY0
+	void skipRegEq(uint16_t X, uint16_t Y);
+
+	// 6XNN
+	void setRegX(uint16_t X, uint16_t NN);
+
+	// 7XNN
+	void addRegX(uint16_t X, uint16_t NN);
+
+	// 8XY0
+	void setRegXY(uint16_t X, uint16_t Y);
+
+	// 8XY1
+	void regOr(uint16_t X, uint16_t Y);
+
+	// 8XY2
+	void regAnd(uint16_t X, uint16_t Y);
+
+	// 8XY3
+	void regXor(uint16_t X, uint16_t Y);
+
+	// 8XY4
+	void addRegXY(uint16_t X, uint16_t Y);
+
+	// 8XY5
+	void subRegXY(uint16_t X, uint16_t Y);
+
+	// 8XY6
+	void shrRegXY(uint16_t X, uint16_t Y);
+
+	// 8XY7
+	void subRegYX(uint16_t X, uint16_t Y);
+
+	// 8XYE
+	void shlRegXY(uint16_t X, uint16_t Y);
+
+	// 9XY0
+	void skipRegNeq(uint16_t X, uint16_t Y);
+
+	// ANNN
+	void setI(uint16_t NNN);
+
+	// BNNN
+	void jumpPlus(uint16_t NNN);
+
+	// CXNN
+	void setXRand(uint16_t X, uint16_t NN);
+
+	// DXYN
+	void draw(uint16_t X, uint16_t Y, uint16_t N);
+
+	// EX9E
+	void skipKeyEq(uint16_t X);
+
+	// EXA1
+	void skipKeyNeq(uint16_t X);
+
+	// FX07
+	void setXDelay(uint16_t X);
+
+	// FX0A
+	void waitForKey(uint16_t X);
+
+	// FX15
+	void setDelayX(uint16_t X);
+
+	// FX18
+	void setSoundX(uint16_t X);
+
+	// FX1E
+	void addXI(uint16_t X);
+
+	// FX29
+	void setISprite(uint16_t X);
+
+	// FX33
+	void setIBCD(uint16_t X);
+
+	// FX55
+	void regDump(uint16_t X);
+
+	// FX65
+	void regLoad(uint16_t X);
+};
+
+#endif
@@ -0,0 +1,344 @@
+/*
+	File:		chip8_env.cpp
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "chip8.h"
+#include "chip8_env.h"
+
+static_assert(sizeof(chip8_env_obs) % 64 == 0, "Observations must fill whole cache lines.");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Futex words must be plain 32-bit integers.");
+
+const uint32_t ENV_MAGIC = 0x43384556; // "C8EV"
+const uint32_t ENV_VERSION = 3;
+
+// Spin this many times before sleeping on the futex. A step
+// usually finishes in a few microseconds, well under a syscall round trip.
+// Spinning only helps when the other side has a core of its own.
+const int SPIN_LIMIT = 4000;
+static const int spinLimit = std::thread::hardware_concurrency() > 1 ? SPIN_LIMIT : 0;
+
+enum EnvCommand : uint32_t {
+	CMD_STEP = 0,
+	CMD_RESET = 1,
+	CMD_SHUTDOWN = 2
+};
+
+// Start of the shared region. Actions and then observations
+// follow it, each starting on a cache line.
+struct EnvHeader {
+	std::atomic<uint32_t> magic;
+	uint32_t version;
+	uint32_t numEnvs;
+	uint32_t actionsOffset;
+	uint32_t obsOffset;
+	uint32_t totalSize;
+
+	alignas(64) std::atomic<uint32_t> requestSeq;	// Bumped by the client
+	std::atomic<uint32_t> serverSleeping;			// Set while the server waits on requestSeq
+	uint32_t command;
+
+	alignas(64) std::atomic<uint32_t> responseSeq;	// Bumped by the server
+	std::atomic<uint32_t> clientSleeping;			// Set while the client waits on responseSeq
+};
+
+static size_t alignUp(size_t n) { return (n + 63) & ~size_t(63); }
+
+// Shared (not private) futexes, so they work across processes.
+static void futexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+}
+
+static void futexWake(std::atomic<uint32_t>* word) {
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+// Publish a new value, and only pay for the wake syscall when the
+// other side has given up spinning. Together with waitForChange()
+// this is a store then load on both sides (sequentially consistent),
+// so either the waiter sees the value or we see it sleeping.
+static void publish(std::atomic<uint32_t>* word, uint32_t value, std::atomic<uint32_t>* sleeping) {
+	word->store(value, std::memory_order_seq_cst);
+	if (sleeping->load(std::memory_order_seq_cst))
+		futexWake(word);
+}
+
+// Wait until 'word' no longer holds 'seen' and return its new value.
+static uint32_t waitForChange(std::atomic<uint32_t>* word, uint32_t seen, std::atomic<uint32_t>* sleeping) {
+	for (int i = 0; i < spinLimit; i++) {
+		uint32_t now = word->load(std::memory_order_acquire);
+		if (now != seen)
+			return now;
+	}
+	for (;;) {
+		sleeping->store(1, std::memory_order_seq_cst);
+		uint32_t now = word->load(std::memory_order_seq_cst);
+		if (now != seen) {
+			sleeping->store(0, std::memory_order_relaxed);
+			return now;
+		}
+		futexWait(word, seen);
+	}
+}
+
+static void* mapRegion(int fd, size_t size) {
+	void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	return base == MAP_FAILED ? nullptr : base;
+}
+
+////////////////////////////////
+/*	        SERVER           */
+//////////////////////////////
+
+struct chip8_env_server {
+	std::string name;
+	EnvHeader* header = nullptr;
+	uint16_t* actions = nullptr;
+	chip8_env_obs* obs = nullptr;
+	std::unique_ptr<Chip8PageArena> arena; // Outlives the machines
+	std::vector<Chip8> machines;
+	Chip8Snapshot pristine;
+	chip8_env_config config;
+};
+
+static void writeObservation(chip8_env_server* server, uint32_t env) {
+	const Chip8& machine = server->machines[env];
+	const Chip8State& state = machine.state();
+	chip8_env_obs& out = server->obs[env];
+	if (out.frameHash != state.frameHash) { // Most frames leave the screen alone
+		memcpy(out.screen, state.screen, sizeof(out.screen));
+		out.frameHash = state.frameHash;
+	}
+	for (uint32_t t = 0; t < server->config.numRamTaps; t++)
+		out.ram[t] = machine.readRAM(server->config.ramTaps[t]);
+	out.halted = machine.isHalted();
+}
+
+static void resetAll(chip8_env_server* server) {
+	for (uint32_t env = 0; env < server->config.numEnvs; env++) {
+		server->machines[env].restore(server->pristine);
+		server->obs[env].frame = 0;
+		writeObservation(server, env);
+	}
+}
+
+static void stepAll(chip8_env_server* server) {
+	for (uint32_t env = 0; env < server->config.numEnvs; env++) {
+		Chip8& machine = server->machines[env];
+		if (machine.isHalted())
+			continue;
+		machine.setKeys(server->actions[env]);
+		machine.runFrame(server->config.instructionsPerFrame);
+		server->obs[env].frame++;
+		writeObservation(server, env);
+	}
+}
+
+chip8_env_server* chip8_env_server_create(const char* name, const chip8_env_config* config,
+	const uint8_t* rom, size_t romSize) {
+	if (!name || !config || config->numEnvs == 0 || config->numRamTaps > CHIP8_ENV_MAX_RAM_TAPS)
+		return nullptr;
+	if (config->numEnvs > static_cast<uint32_t>(Chip8PageArena::MAX_MACHINES))
+		return nullptr; // One arena has to back every page of every machine
+	if (romSize > C8_RAM_SIZE - C8_PROGRAM_START)
+		return nullptr;
+
+	size_t actionsOffset = alignUp(sizeof(EnvHeader));
+	size_t obsOffset = alignUp(actionsOffset + config->numEnvs * sizeof(uint16_t));
+	size_t totalSize = obsOffset + config->numEnvs * sizeof(chip8_env_obs);
+
+	// O_EXCL: never take the name over from a server that is still live.
+	int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (fd < 0)
+		return nullptr;
+	if (ftruncate(fd, totalSize) != 0) {
+		close(fd);
+		shm_unlink(name);
+		return nullptr;
+	}
+	void* base = mapRegion(fd, totalSize);
+	close(fd);
+	if (!base) {
+		shm_unlink(name);
+		return nullptr;
+	}
+
+	// Nothing may throw past the C interface, so a failed allocation
+	// is turned into NULL and leaves no region behind.
+	chip8_env_server* server = nullptr;
+	try {
+		server = new chip8_env_server;
+		server->name = name;
+		server->config = *config;
+		if (server->config.instructionsPerFrame == 0)
+			server->config.instructionsPerFrame = C8_INSTRUCTIONS_PER_FRAME;
+
+		// Every machine shares one image of the ROM and only copies the
+		// pages it writes to, into an arena with room for all of them.
+		std::shared_ptr<const Chip8Image> image = makeROMImage(rom, romSize);
+		server->arena.reset(new Chip8PageArena(static_cast<int>(config->numEnvs) * C8_PAGE_COUNT));
+		server->machines.reserve(config->numEnvs);
+		for (uint32_t env = 0; env < config->numEnvs; env++)
+			server->machines.emplace_back(*server->arena);
+		for (Chip8& machine : server->machines) {
+			machine.loadImage(image);
+			machine.setBitwiseQuirk(config->bitwiseQuirk != 0);
+			machine.setShiftQuirk(config->shiftQuirk != 0);
+			machine.setFaultPolicy(FaultPolicy::Halt);
+		}
+		server->machines[0].save(server->pristine);
+
+		char* bytes = static_cast<char*>(base);
+		server->header = new (bytes) EnvHeader();
+		server->actions = reinterpret_cast<uint16_t*>(bytes + actionsOffset);
+		server->obs = reinterpret_cast<chip8_env_obs*>(bytes + obsOffset);
+		server->header->version = ENV_VERSION;
+		server->header->numEnvs = config->numEnvs;
+		server->header->actionsOffset = actionsOffset;
+		server->header->obsOffset = obsOffset;
+		server->header->totalSize = totalSize;
+		resetAll(server);
+	}
+	catch (...) {
+		delete server;
+		munmap(base, totalSize);
+		shm_unlink(name);
+		return nullptr;
+	}
+
+	// Publish last, so a client never sees a half built region.
+	server->header->magic.store(ENV_MAGIC, std::memory_order_release);
+	return server;
+}
+
+int chip8_env_server_serve(chip8_env_server* server) {
+	EnvHeader* header = server->header;
+	// Start from the last answered request, not the latest one: the
+	// client may already have sent a request before we got here.
+	uint32_t seen = header->responseSeq.load(std::memory_order_acquire);
+	for (;;) {
+		seen = waitForChange(&header->requestSeq, seen, &header->serverSleeping);
+		uint32_t command = header->command;
+		if (command == CMD_SHUTDOWN)
+			break;
+		else if (command == CMD_RESET)
+			resetAll(server);
+		else
+			stepAll(server);
+		publish(&header->responseSeq, seen, &header->clientSleeping);
+	}
+	publish(&header->responseSeq, seen, &header->clientSleeping);
+	return 0;
+}
+
+int chip8_env_server_unlink(const char* name) {
+	return name && shm_unlink(name) == 0 ? 0 : -1;
+}
+
+void chip8_env_server_destroy(chip8_env_server* server) {
+	if (!server)
+		return;
+	munmap(server->header, server->header->totalSize);
+	shm_unlink(server->name.c_str());
+	delete server;
+}
+
+////////////////////////////////
+/*	        CLIENT           */
+//////////////////////////////
+
+struct chip8_env_client {
+	EnvHeader* header = nullptr;
+	uint16_t* actions = nullptr;
+	chip8_env_obs* obs = nullptr;
+	size_t size = 0;
+	uint32_t seq = 0;
+};
+
+chip8_env_client* chip8_env_client_open(const char* name) {
+	int fd = shm_open(name, O_RDWR, 0600);
+	if (fd < 0)
+		return nullptr;
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size < (off_t) sizeof(EnvHeader)) {
+		close(fd);
+		return nullptr;
+	}
+	void* base = mapRegion(fd, info.st_size);
+	close(fd);
+	if (!base)
+		return nullptr;
+
+	EnvHeader* header = static_cast<EnvHeader*>(base);
+	if (header->magic.load(std::memory_order_acquire) != ENV_MAGIC || header->version != ENV_VERSION) {
+		munmap(base, info.st_size);
+		return nullptr;
+	}
+
+	chip8_env_client* client = new chip8_env_client;
+	char* bytes = static_cast<char*>(base);
+	client->header = header;
+	client->actions = reinterpret_cast<uint16_t*>(bytes + header->actionsOffset);
+	client->obs = reinterpret_cast<chip8_env_obs*>(bytes + header->obsOffset);
+	client->size = info.st_size;
+	client->seq = header->requestSeq.load(std::memory_order_acquire);
+	return client;
+}
+
+uint32_t chip8_env_client_num_envs(const chip8_env_client* client) {
+	return client->header->numEnvs;
+}
+
+uint16_t* chip8_env_client_actions(chip8_env_client* client) {
+	return client->actions;
+}
+
+const chip8_env_obs* chip8_env_client_observations(const chip8_env_client* client) {
+	return client->obs;
+}
+
+// Hand one command to the server and wait for it to finish.
+static int request(chip8_env_client* client, uint32_t command) {
+	EnvHeader* header = client->header;
+	header->command = command;
+	uint32_t seq = ++client->seq;
+	publish(&header->requestSeq, seq, &header->serverSleeping);
+
+	uint32_t done = header->responseSeq.load(std::memory_order_acquire);
+	while (done != seq)
+		done = waitForChange(&header->responseSeq, done, &header->clientSleeping);
+	return 0;
+}
+
+int chip8_env_client_step(chip8_env_client* client) {
+	return request(client, CMD_STEP);
+}
+
+int chip8_env_client_reset(chip8_env_client* client) {
+	return request(client, CMD_RESET);
+}
+
+int chip8_env_client_shutdown(chip8_env_client* client) {
+	return request(client, CMD_SHUTDOWN);
+}
+
+void chip8_env_client_close(chip8_env_client* client) {
+	if (!client)
+		return;
+	munmap(client->header, client->size);
+	delete client;
+}
@@ -0,0 +1,105 @@
+/*
+	File:		chip8_env.h
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+
+	C API for stepping many CHIP-8 machines from another process.
+
+	A server owns K machines running the same ROM and a POSIX shared
+	memory region. A client maps the same region, writes one 16-bit
+	keypad mask per machine into the action slots, and calls
+	chip8_env_client_step(). The server runs every machine for one
+	frame and writes the packed screen and the tapped RAM bytes
+	straight into the observation slots. Both sides signal each
+	other with futexes on the shared region, so no step goes through
+	a socket or a serializer.
+
+	Linux only.
+*/
+#pragma once
+#ifndef CHIP8_ENV_H
+#define CHIP8_ENV_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CHIP8_ENV_MAX_RAM_TAPS 16
+
+typedef struct chip8_env_config {
+	uint32_t numEnvs;
+	uint32_t instructionsPerFrame;	// 0 = C8_INSTRUCTIONS_PER_FRAME
+	uint32_t numRamTaps;
+	uint16_t ramTaps[CHIP8_ENV_MAX_RAM_TAPS]; // RAM addresses copied into every observation (score, lives...)
+	uint8_t bitwiseQuirk;
+	uint8_t shiftQuirk;
+} chip8_env_config;
+
+// One machine's view after a step. 64-byte aligned so
+// neighbouring machines never share a cache line.
+typedef struct chip8_env_obs {
+	uint64_t screen[32];	// One bit per pixel, bit 63 is the leftmost column
+	uint8_t ram[CHIP8_ENV_MAX_RAM_TAPS];
+	uint64_t frameHash;		// Equal screens have equal hashes. 0 for a blank screen.
+	uint32_t frame;			// Frames since the last reset
+	uint8_t halted;			// Hit a fault (e.g. an unknown instruction). Stays set until reset.
+	uint8_t pad[35];
+} chip8_env_obs;
+
+typedef struct chip8_env_server chip8_env_server;
+typedef struct chip8_env_client chip8_env_client;
+
+/* Server */
+
+// Create the region 'name' (e.g. "/chip8-env") and numEnvs machines running 'rom'.
+// numEnvs can be at most 4096. Returns NULL on failure, including when 'name'
+// already exists.
+chip8_env_server* chip8_env_server_create(const char* name, const chip8_env_config* config,
+	const uint8_t* rom, size_t romSize);
+
+// Serve step and reset requests until a client asks for a shutdown.
+// Returns 0 on a clean shutdown.
+int chip8_env_server_serve(chip8_env_server* server);
+
+// Remove a region left behind by a server that crashed. Only for a name
+// nothing is serving anymore. Returns 0 if a region was removed.
+int chip8_env_server_unlink(const char* name);
+
+// Unmap and unlink the region.
+void chip8_env_server_destroy(chip8_env_server* server);
+
+/* Client */
+
+// Map an existing region. Returns NULL if it does not exist yet.
+chip8_env_client* chip8_env_client_open(const char* name);
+
+uint32_t chip8_env_client_num_envs(const chip8_env_client* client);
+
+// Action slots, one keypad mask per machine (bit N = key N held).
+// Write them in place before each step.
+uint16_t* chip8_env_client_actions(chip8_env_client* client);
+
+// Observation slots, valid until the next step or reset.
+const chip8_env_obs* chip8_env_client_observations(const chip8_env_client* client);
+
+// Run every machine for one frame with the current actions.
+// Blocks until the observations are ready. Returns 0 on success.
+int chip8_env_client_step(chip8_env_client* client);
+
+// Put every machine back to its freshly loaded state.
+int chip8_env_client_reset(chip8_env_client* client);
+
+// Stop the server. Blocks until it has stopped serving.
+int chip8_env_client_shutdown(chip8_env_client* client);
+
+// Unmap the region. The server keeps running for other clients.
+void chip8_env_client_close(chip8_env_client* client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
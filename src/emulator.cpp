@@ -6,34 +6,37 @@
 
 #include <iostream>
 #include <cstdlib>
-#include <fstream>
 #include <string>
 #include <stdint.h>
-#include <map>
-#include <stack>
+#include <vector>
 #include <stdexcept>
 #include <chrono>
+#include <fstream>
 #include "SDL3/SDL.h"
 #include "emulator.h"
-
-
-uint8_t fontData[80] =
-{ 0xF0, 0x90, 0x90, 0x90, 0xF0,  // 0
- 0x20, 0x60, 0x20, 0x20, 0x70,   // 1
- 0xF0, 0x10, 0xF0, 0x80, 0xF0,   // 2
- 0xF0, 0x10, 0xF0, 0x10, 0xF0,   // 3
- 0x90, 0x90, 0xF0, 0x10, 0x10,   // 4
- 0xF0, 0x80, 0xF0, 0x10, 0xF0,   // 5
- 0xF0, 0x80, 0xF0, 0x90, 0xF0,   // 6
- 0xF0, 0x10, 0x20, 0x40, 0x40,   // 7
- 0xF0, 0x90, 0xF0, 0x90, 0xF0,   // 8
- 0xF0, 0x90, 0xF0, 0x10, 0xF0,   // 9
- 0xF0, 0x90, 0xF0, 0x90, 0x90,   // A
- 0xE0, 0x90, 0xE0, 0x90, 0xE0,   // B
- 0xF0, 0x80, 0x80, 0x80, 0xF0,   // C
- 0xE0, 0x90, 0x90, 0x90, 0xE0,   // D
- 0xF0, 0x80, 0xF0, 0x80, 0xF0,   // E
- 0xF0, 0x80, 0xF0, 0x80, 0x80 }; // F
+#include "keymap.h"
+
+#ifdef _WIN32
+extern "C" __declspec(dllimport) int __stdcall IsDebuggerPresent(void);
+#endif
+
+// Whether a debugger is attached to us right now. Reads /proc on
+// Linux, so this is for setup only, not for the fault path.
+static bool debuggerAttached() {
+#if defined(_WIN32)
+	return IsDebuggerPresent() != 0;
+#elif defined(__linux__)
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 10, "TracerPid:") == 0)
+			return std::strtol(line.c_str() + 10, nullptr, 10) != 0;
+	}
+	return false;
+#else
+	return false;
+#endif
+}
 
 // Initialize Emulator and SDL
 Emulator::Emulator() {
@@ -46,299 +49,248 @@ Emulator::Emulator() {
 	running = false;
 	listener = SDL_Event();
 
-	// Emulator Values
-	memset(RAM, 0, sizeof(RAM));
-	memset(V, 0, sizeof(V));
-	memset(screen, 0, sizeof(screen));
-	lastFrame = {};
-	lastTick = {};
-	PC = 200;
-	I = 0;
-	delayTimer = 0;
-	soundTimer = 0;
-	shiftVY = false;
-	resetVF = false;
-	incrementOnlyByX = false;
-	incrementNone = false;
-
-	/*
-		Key Map Layout
-		1 2 3 4
-		q w e r
-		a s d f
-		z x c v
-	*/
-	keyMap.insert(mapEntry(SDL_SCANCODE_1, keyInfo(0)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_2, keyInfo(1)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_3, keyInfo(2)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_4, keyInfo(3)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_Q, keyInfo(4)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_W, keyInfo(5)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_E, keyInfo(6)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_R, keyInfo(7)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_A, keyInfo(8)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_S, keyInfo(9)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_D, keyInfo(10)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_F, keyInfo(11)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_Z, keyInfo(12)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_X, keyInfo(13)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_C, keyInfo(14)));
-	keyMap.insert(mapEntry(SDL_SCANCODE_V, keyInfo(15)));
 }
 
-// Load given file and predefined font into RAM.
+// Load given file into RAM. The font is already there.
 void Emulator::readROM(const std::string& PathToROM) {
-	std::ifstream inFile(PathToROM, std::ios::binary);
-	if (!inFile.is_open())
-		throw std::runtime_error("Unable to open ROM. Double check the file path.");
-
-	inFile.seekg(0, inFile.end);
-	std::streamsize inFileSize = inFile.tellg();
-	inFile.seekg(0, inFile.beg);
-
-	if (inFileSize < 0)
-		throw std::runtime_error("Unable to read file size.");
-	else if (inFileSize + 0x200 > 4096)
-		throw std::runtime_error("ROM is too large to store in RAM.");
-	
-	inFile.seekg(0, std::ios::beg);
-	if (!inFile.read(reinterpret_cast<char*>(&RAM[0x200]), inFileSize))
-		throw std::runtime_error("Unable to open ROM");
-	
-	inFile.close(); 
-	memcpy(&RAM[0], fontData, sizeof(fontData)); 
+	std::vector<uint8_t> rom = readROMFile(PathToROM);
+	core.loadROM(rom.data(), rom.size());
 }
 
 void Emulator::tick() {
 	// Handle Time
-	auto now = std::chrono::high_resolution_clock::now();
-	std::chrono::duration<double, std::milli> tickDiff = now - lastTick;
-	std::chrono::duration<double, std::milli> frameDiff = now - lastFrame;
-
-	double tickDelta = tickDiff.count();
-	double frameDelta = frameDiff.count();
-
-	if (tickDelta < TICK_SPEED_MS)
+	int due = pacer.instructionsDue(FramePacer::clock::now());
+	if (due == 0) {
+		SDL_DelayNS(IDLE_WAIT_NS); // Next instruction is not due yet
 		return;
-
-	// Update Timers
-	if (frameDelta >= SIXTY_HZ_MS) {
-		if (delayTimer > 0) delayTimer--;
-		if (soundTimer > 0) soundTimer--;
-		if (!drawOnCall)
-			swapBuffers();
-		lastFrame = hires_clock::now();
 	}
 
-	if (waitingForKey) {
-		lastTick = hires_clock::now();
+	// Run everything that is due. Instructions and timers are never
+	// skipped. If this is a catch up burst, the pacer's level decides
+	// which presents can be dropped.
+	PacingLevel level = pacer.level();
+	if (timing == TimingModel::CosmacVip || lowLatency) {
+		runFrames(due, level);
 		return;
 	}
 
-	// OPCODE Decision Tree
-	try {
-		execute();
-	}
-	catch (const std::runtime_error& e) {
-		uint16_t code = std::stoi(e.what());
-		std::string userInput;
-		std::cout << "Unknown instruction: " << std::hex << code << std::dec << "\n";
-		std::cout << "Skip instruction and continue? Y or N.\n" << "Input: ";
-		std::cin >> userInput;
-		if (userInput.at(0) != 'Y' || userInput.at(0) != 'y')
-			running = false;
-			
+	bool presentPending = false;
+	for (int slot = 0; slot < due; slot++) {
+		bool finalFrame = due - slot <= C8_INSTRUCTIONS_PER_FRAME;
+		bool presentNow = level == PacingLevel::Normal || finalFrame;
+
+		step();
+
+		if (core.takeScreenUpdate() && drawOnCall) {
+			if (presentNow && level != PacingLevel::Coalesce) {
+				present();
+			}
+			else {
+				presentPending = true;
+				if (level == PacingLevel::Coalesce)
+					pacer.stats.coalescedPresents++;
+				else
+					pacer.stats.skippedPresents++;
+			}
+		}
+
+		// Update Timers
+		if (++frameSlot == C8_INSTRUCTIONS_PER_FRAME) {
+			frameSlot = 0;
+			core.tickTimers();
+			pacer.stats.framesRun++;
+			if (!drawOnCall) {
+				if (presentNow)
+					present();
+				else
+					pacer.stats.skippedPresents++;
+			}
+		}
 	}
-	
-	lastTick = std::chrono::high_resolution_clock::now();
+
+	if (presentPending)
+		present();
+	trackLatency();
 }
 
-void Emulator::execute() {
-	// Useful parts of instruction
-	uint8_t leftByte = RAM[PC];
-	uint8_t rightByte = RAM[PC + 1];
-	uint16_t bothByte = ((uint16_t) leftByte << 8) | rightByte;
-	uint8_t firstNib = leftByte >> 4; // Leftmost
-	uint8_t secondNib = leftByte & 0xf;
-	uint8_t thirdNib = rightByte >> 4;
-	uint8_t fourthNib = rightByte & 0xf; // Rightmost
-	PC += 2;
+// Run whole frames at once. Under COSMAC VIP timing the pacer's slots
+// only count off frames and the core decides how many instructions fit
+// in each one. In low latency mode the last frame of the batch polls
+// input just before it runs, and is presented as soon as it is done.
+void Emulator::runFrames(int due, PacingLevel level) {
+	frameSlot += due;
+	int frames = frameSlot / C8_INSTRUCTIONS_PER_FRAME;
+	frameSlot %= C8_INSTRUCTIONS_PER_FRAME;
+
+	bool presentPending = false;
+	for (int frame = 0; frame < frames; frame++) {
+		bool finalFrame = frame == frames - 1;
+		if (lowLatency && finalFrame)
+			pollEvents();
 
-	switch (firstNib)
-	{
-	case 0:
-		if (leftByte == 0x00 && rightByte == 0xEE)
-			returnFunc();
-		else if (leftByte == 0x00 && rightByte == 0xE0)
-			clearDisplay();
-		else
-			callFunc(0xCAFE); // Instruction Ignored
-		break;
-	case 1:
-		jump(bothByte & 0x0FFF);
-		break;
-	case 2:
-		callFuncAt(bothByte & 0x0FFF);
-		break;
-	case 3:
-		skipEq(secondNib, rightByte);
-		break;
-	case 4:
-		skipNeq(secondNib, rightByte);
-		break;
-	case 5:
-		skipRegEq(secondNib, thirdNib);
-		break;
-	case 6:
-		setRegX(secondNib, rightByte);
-		break;
-	case 7:
-		addRegX(secondNib, rightByte);
-		break;
-	case 8:
-		switch (fourthNib) {
-		case 0x0:
-			setRegXY(secondNib, thirdNib);
-			break;
-		case 0x1:
-			regOr(secondNib, thirdNib);
-			break;
-		case 0x2:
-			regAnd(secondNib, thirdNib);
-			break;
-		case 0x3:
-			regXor(secondNib, thirdNib);
-			break;
-		case 0x4:
-			addRegXY(secondNib, thirdNib);
-			break;
-		case 0x5:
-			subRegXY(secondNib, thirdNib);
-			break;
-		case 0x6:
-			shrRegXY(secondNib, thirdNib);
-			break;
-		case 0x7:
-			subRegYX(secondNib, thirdNib);
-			break;
-		case 0xE:
-			shlRegXY(secondNib, thirdNib);
-			break;
-		default:
-			throw std::runtime_error(std::to_string(bothByte));
-			break;
+		if (timing == TimingModel::CosmacVip) {
+			reportStatus(core.runVipFrame());
+		}
+		else {
+			for (int i = 0; i < C8_INSTRUCTIONS_PER_FRAME; i++)
+				step();
+			core.tickTimers();
+		}
+		pacer.stats.framesRun++;
+		trackLatency();
+
+		bool updated = core.takeScreenUpdate();
+		if (drawOnCall && !updated)
+			continue;
+		if (level == PacingLevel::Normal || finalFrame) {
+			present();
+			presentPending = false;
 		}
-		break;
-	case 9:
-		if (fourthNib == 0x0)
-			skipRegNeq(secondNib, thirdNib);
-		else
-			throw std::runtime_error(std::to_string(bothByte));
-		break;
-	case 0xA:
-		setI(bothByte & 0x0FFF);
-		break;
-	case 0xB:
-		jumpPlus(bothByte & 0x0FFF);
-		break;
-	case 0xC:
-		setXRand(secondNib, rightByte);
-		break;
-	case 0xD:
-		draw(secondNib, thirdNib, fourthNib);
-		break;
-	case 0xE:
-		if (rightByte == 0x9E)
-			skipKeyEq(secondNib);
-		else if (rightByte == 0xA1)
-			skipKeyNeq(secondNib);
-		else
-			throw std::runtime_error(std::to_string(bothByte));
-		break;
-	case 0xF:
-		switch (rightByte)
-		{
-		case 0x07:
-			setXDelay(secondNib);
-			break;
-		case 0x0A:
-			waitForKey(secondNib);
-			break;
-		case 0x15:
-			setDelayX(secondNib);
-			break;
-		case 0x18:
-			setSoundX(secondNib);
-			break;
-		case 0x1E:
-			addXI(secondNib);
-			break;
-		case 0x29:
-			setISprite(secondNib);
-			break;
-		case 0x33:
-			setIBCD(secondNib);
-			break;
-		case 0x55:
-			regDump(secondNib);
-			break;
-		case 0x65:
-			regLoad(secondNib);
-			break;
-		default:
-			throw std::runtime_error(std::to_string(bothByte));
-			break;
+		else {
+			presentPending = presentPending || updated;
+			pacer.stats.skippedPresents++;
+		}
+	}
+
+	if (presentPending)
+		present();
+}
+
+// Execute one instruction, unless the machine is waiting for a key or halted.
+void Emulator::step() {
+	if (core.isWaitingForKey() || core.isHalted())
+		return;
+
+	// OPCODE Decision Tree
+	reportStatus(core.execute());
+}
+
+void Emulator::reportStatus(Chip8Status status) {
+	if (status != Chip8Status::Ok) {
+		logger.post(core.lastFault());
+		if (isFault(status) && faultPolicy == FaultPolicy::Break) {
+			// Trapping with no debugger attached would kill the emulator.
+			if (debuggerPresent) {
+				SDL_TriggerBreakpoint();
+			}
+			else {
+				core.halt();
+				logger.post("No debugger attached, halting instead of breaking.");
+			}
 		}
-		break;
-	default:
-		throw std::runtime_error(std::to_string(bothByte));
-		break;
 	}
+}
 
+// Pass newly seen key reads and draws to the latency tracker. Only
+// looks at the clock when the sample in flight is waiting on one.
+void Emulator::trackLatency() {
+	bool read = core.keyReadCount() != seenKeyReads;
+	bool drawn = core.drawCount() != seenDraws;
+	seenKeyReads = core.keyReadCount();
+	seenDraws = core.drawCount();
+	if ((read && latency.waitingForRead()) || (drawn && latency.waitingForDraw())) {
+		Uint64 now = SDL_GetTicksNS();
+		if (read)
+			latency.keyRead(now);
+		if (drawn)
+			latency.drew(now);
+	}
 }
+
+// Skipped when the frame hash says the screen has not changed
+// since the last present (e.g. a sprite drawn and erased again).
+// A latency sample waiting on a present stays open until a real one.
+void Emulator::present() {
+	trackLatency();
+	if (!core.changedSincePresent()) {
+		pacer.stats.unchangedPresents++;
+		return;
+	}
+	swapBuffers();
+	core.markPresented();
+	pacer.stats.presents++;
+	if (latency.waitingForPresent())
+		latency.presented(SDL_GetTicksNS());
+}
+
+void Emulator::setFaultPolicy(FaultPolicy policy) {
+	faultPolicy = policy;
+	core.setFaultPolicy(policy);
+	if (policy == FaultPolicy::Break)
+		debuggerPresent = debuggerAttached();
+}
+
+void Emulator::setLowLatencyMode(bool setting) {
+	lowLatency = setting;
+	latency.setLowLatency(setting);
+	SDL_SetWindowTitle(window, lowLatency ? "CHIP-8 (low latency)" : "CHIP-8");
+}
+
 void Emulator::run() {
 	running = true;
+	frameSlot = 0;
+	swapBuffers(); // First frame, whatever the hash says
+	core.markPresented();
+	pacer.start(FramePacer::clock::now());
 	while (running) { 
-		pollEvents();
+		if (!lowLatency)
+			pollEvents(); // Otherwise polled right before each frame
 		tick();
 	}
-	std::cout << "Emulator shutting down..." << std::endl;
+
+	const PacingStats& stats = pacer.stats;
+	std::cout << "Emulator shutting down..." << "\n"
+		<< "Frames: " << stats.framesRun << ", presented: " << stats.presents
+		<< ", skipped: " << stats.skippedPresents << ", coalesced: " << stats.coalescedPresents
+		<< ", unchanged: " << stats.unchangedPresents
+		<< ", dropped: " << stats.droppedFrames << ", max lag: " << stats.maxLagMs << "ms" << std::endl;
+	latency.report(std::cout);
 }
 
 // Handles all input
 void Emulator::pollEvents() {
 	while (SDL_PollEvent(&listener)) {
-		SDL_Scancode scancode;
+		int key;
 		switch (listener.type) {
 			case SDL_EVENT_QUIT:
 				running = false;
 				break;
+			case SDL_EVENT_WINDOW_EXPOSED:
+				swapBuffers(); // Redraw even though the screen has not changed
+				break;
 			case SDL_EVENT_KEY_UP:
-				scancode = listener.key.scancode;
-				if (isValidKey(scancode)) {
-					keyMap.at(scancode).down = false;
-					if (waitingForKey) { // FX0A Functionality 
-						waitingForKey = false;
-						V[waitingRegister] = keyMap.at(scancode).mappedNum;
-					}
+				key = keypadIndex(listener.key.scancode);
+				if (key >= 0) {
+					latency.inputArrived(listener.key.timestamp);
+					core.releaseKey(key); // Also completes FX0A
 				}
 				break;
 			case SDL_EVENT_KEY_DOWN:
-				scancode = listener.key.scancode;
-				if (isValidKey(scancode))
-					keyMap.at(scancode).down = true;
+				if (listener.key.scancode == SDL_SCANCODE_F2 && !listener.key.repeat) {
+					setLowLatencyMode(!lowLatency);
+					break;
+				}
+				key = keypadIndex(listener.key.scancode);
+				if (key >= 0) {
+					if (!listener.key.repeat)
+						latency.inputArrived(listener.key.timestamp);
+					core.pressKey(key);
+				}
 				break;
 		}
 	}
+	trackLatency(); // FX0A completes on key up
 }
 
 // Draw the screen buffer to the screen
 // Sets draw color to black.
+// Returns once the frame is handed to the display, which is as
+// close to the photon as latency measurements get.
 void Emulator::swapBuffers() const {
 	SDL_RenderClear(renderer);
 	for (int i = 0; i < C8_HEIGHT; i++) {
 		for (int j = 0; j < C8_WIDTH; j++) {
-			uint8_t color = (screen[i][j] == 1) ? 255 : 0;
+			uint8_t color = core.pixel(j, i) ? 255 : 0;
 			const SDL_FRect pixel = { j, i, 1.0f, 1.0f };
 			SDL_SetRenderDrawColor(renderer, color, color, color, 255);
 			SDL_RenderFillRect(renderer, &pixel);
@@ -346,262 +298,4 @@ void Emulator::swapBuffers() const {
 	}
 	SDL_RenderPresent(renderer);
 	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-	SDL_Delay(1);
-}
-
-bool Emulator::isValidKey(SDL_Scancode& key) const {
-	return keyMap.find(key) != keyMap.end();
-}
-
-// Returns the bit in 'place' of 'number'
-// The least significant bit is 'place' 0.
-uint8_t Emulator::getBit(uint8_t number, uint8_t place) const {
-	return (number >> place) & 1;
-}
-
-uint16_t Emulator::sprite_addr(uint8_t hex) const {
-	return hex * 5;
-}
-////////////////////////////////
-/*	        OPCODES          */
-//////////////////////////////
-
-void Emulator::callFunc(uint16_t NNN) { 
-	std::cout << "INSTRUCTION IGNORED: 0NNN" << std::endl;
-}
-
-
-void Emulator::clearDisplay() {
-	memset(screen, 0, sizeof(screen));
-	swapBuffers();
-}
-
-void Emulator::returnFunc() {
-	try {
-		PC = Stack.top(); 
-		Stack.pop();
-	}
-	catch (std::exception&) {
-		std::cout << "STACK EMPTY. OPCODE 00EE (returnFunc)." << std::endl;
-	}
-}
-
-void Emulator::jump(uint16_t NNN) { PC = NNN; }
-
-void Emulator::callFuncAt(uint16_t NNN) { 
-	Stack.push(PC);
-	PC = NNN;
-}
-
-void Emulator::skipEq(uint16_t X, uint16_t NN) {
-	if (V[X] == NN)
-		PC += 2;
-}
-
-void Emulator::skipNeq(uint16_t X, uint16_t NN) {
-	if (V[X] != NN)
-		PC += 2;
-}
-
-void Emulator::skipRegEq(uint16_t X, uint16_t Y) {
-	if (V[X] == V[Y])
-		PC += 2;
-}
-
-void Emulator::setRegX(uint16_t X, uint16_t NN) { V[X] = NN; }
-
-void Emulator::addRegX(uint16_t X, uint16_t NN) { V[X] += NN; }
-
-void Emulator::setRegXY(uint16_t X, uint16_t Y) { V[X] = V[Y]; }
-
-void Emulator::regOr(uint16_t X, uint16_t Y) { 
-	V[X] |= V[Y];
-	if (resetVF)
-		V[0xF] = 0; // QUIRK 5
-}
-void Emulator::regAnd(uint16_t X, uint16_t Y) { 
-	V[X] &= V[Y];
-	if (resetVF)
-		V[0xF] = 0; // QUIRK 5
-}
-
-void Emulator::regXor(uint16_t X, uint16_t Y) { 
-	V[X] ^= V[Y];
-
-	if (resetVF)
-		V[0xF] = 0; // QUIRK 5
-}
-
-void Emulator::addRegXY(uint16_t X, uint16_t Y) {
-	uint16_t sum = V[X] + V[Y]; // Ensure flag stays set if X = F.
-	V[X] += V[Y];
-	V[0xF] = (sum > UINT8_MAX) ? 1 : 0;  
-}
-
-void Emulator::subRegXY(uint16_t X, uint16_t Y) {
-	uint8_t origX = V[X];
-	uint8_t origY = V[Y];
-	V[X] = origX - origY;
-	if (origX >= origY)
-		V[0xF] = 1; // No Underflow
-	else
-		V[0xF] = 0; // Underflow
-}
-
-void Emulator::shrRegXY(uint16_t X, uint16_t Y) {
-	if (shiftVY) { // Quirk 6
-		V[X] = V[Y] >> 1;
-		V[0xF] = V[Y] & 1u;
-	}
-	else {
-		uint8_t bit = V[X] & 1u; // Ensure flag stays set if X = F.
-		V[X] >>= 1;
-		V[0xF] = bit; 
-	}
-}
-
-
-void Emulator::subRegYX(uint16_t X, uint16_t Y) {
-	uint8_t origX = V[X];
-	uint8_t origY = V[Y];
-	V[X] = origY - origX;
-	if (origY >= origX)
-		V[0xF] = 1; // Underflow
-	else
-		V[0xF] = 0; // No underflow
-}
-
-void Emulator::shlRegXY(uint16_t X, uint16_t Y) {
-	if (shiftVY) { // Quirk 6
-		V[X] = V[Y] << 1;
-		V[0xF] = (V[Y] & (1u << 7)) >> 7;
-	}
-	else {
-		uint8_t bit = (V[X] & (1u << 7)) >> 7; // Ensure flag stays set if X = F.
-		V[X] <<= 1;
-		V[0xF] = bit;
-	}
-}
-
-void Emulator::skipRegNeq(uint16_t X, uint16_t Y) {
-	if (V[X] != V[Y])
-		PC += 2;
-}
-
-void Emulator::setI(uint16_t NNN) { I = NNN; }
-
-void Emulator::jumpPlus(uint16_t NNN) { PC = V[0] + NNN; }
-
-void Emulator::setXRand(uint16_t X, uint16_t NN) { V[X] = (rand() % 256) & NN; }
-
-void Emulator::draw(uint16_t X, uint16_t Y, uint16_t N) {
-	uint8_t xOrig = V[X] % C8_WIDTH;
-	uint8_t yOrig = V[Y] % C8_HEIGHT;
-	V[0xf] = 0;
-	for (int i = 0; i < N; i++) {
-		uint8_t row = RAM[I + i];
-		for (int j = 0; j < 8; j++) {
-			if (yOrig + i >= C8_HEIGHT || xOrig + j >= C8_WIDTH) // Clipping
-				continue;
-
-			uint8_t bit = getBit(row, 7 - j);
-			uint8_t& screenBit = screen[yOrig + i][xOrig + j];
-			if (screenBit == 1 && bit == 1) // Flip Check
-				V[0xf] = 1;
-			screenBit ^= bit;
-		}
-	}
-
-	if (drawOnCall)
-		swapBuffers();
-}
-
-void Emulator::skipKeyEq(uint16_t X) {
-	int keyNum = V[X];
-	for (const auto& [scancode, info] : keyMap) {
-		if (info.mappedNum == keyNum && info.down) {
-			PC += 2;
-			break;
-		}
-	}
-}
-
-void Emulator::skipKeyNeq(uint16_t X) {
-	int keyNum = V[X];
-	for (const auto& [scancode, info] : keyMap) {
-		if (info.mappedNum == keyNum && !info.down) {
-			PC += 2;
-			break;
-		}
-	}
-}
-
-void Emulator::setXDelay(uint16_t X) { V[X] = delayTimer; }
-
-void Emulator::waitForKey(uint16_t X) {
-	waitingForKey = true;
-	waitingRegister = X;
-
-	//SDL_Event e;
-	//
-	//while (true) {
-	//	while (SDL_PollEvent(&e)) {
-	//		if (e.type == SDL_EVENT_QUIT) {
-	//			std::exit(0);
-	//		}
-	//
-	//		if (e.type == SDL_EVENT_KEY_DOWN)
-	//		{
-	//			auto search = keyMap.find(e.key.scancode);
-	//			if (search != keyMap.end()) {
-	//				keyInfo& val = search->second;
-	//				val.down = true;
-	//				V[X] = val.mappedNum;
-	//				return;
-	//			}
-	//		}
-	//		SDL_Delay(1);
-	//	}
-	//}
-}
-
-void Emulator::setDelayX(uint16_t X) { delayTimer = V[X]; }
-
-void Emulator::setSoundX(uint16_t X) { soundTimer = V[X]; }
-
-void Emulator::addXI(uint16_t X) { I += V[X]; }
-
-void Emulator::setISprite(uint16_t X) { I = sprite_addr(V[X]); }
-
-void Emulator::setIBCD(uint16_t X) {
-	uint8_t num = V[X];
-	RAM[I] = num / 100;
-	RAM[I + 1] = (num / 10) % 10;
-	RAM[I + 2] = num % 10;	
-}
-
-void Emulator::regDump(uint16_t X) {
-	for (uint8_t i = 0; i <= X; i++) {
-		RAM[I + i] = V[i];
-	}
-	
-	if (incrementOnlyByX) // Quirk 12
-		I += X;
-	else if (incrementNone) // Quirk 12
-		;
-	else
-		I += X + 1;
-}
-
-void Emulator::regLoad(uint16_t X) {
-	for (uint8_t i = 0; i <= X; i++) {
-		V[i] = RAM[I + i];
-	}
-
-	if (incrementOnlyByX) // Quirk 12
-		I += X;
-	else if (incrementNone) // Quirk 12
-		;
-	else
-		I += X + 1;
 }
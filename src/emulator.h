@@ -7,32 +7,22 @@
 #ifndef EMULATOR_H
 #define EMULATOR_H
 
-#include <chrono>
-#include <map>
-#include <stack>
 #include <string>
 #include "SDL3/SDL.h"
+#include "chip8.h"
+#include "latency.h"
+#include "logger.h"
+#include "pacing.h"
 
 
-struct keyInfo {
-	keyInfo(int num) {
-		mappedNum = num;
-		down = false;
-	}
+const uint64_t IDLE_WAIT_NS = 100 * 1000;
 
-	int mappedNum;
-	bool down;
+// How fast the guest runs.
+enum class TimingModel {
+	Fixed,		// C8_INSTRUCTIONS_PER_FRAME instructions per frame, whatever they are
+	CosmacVip	// Each instruction costs what it did on the COSMAC VIP
 };
 
-using std::map, std::stack;
-using mapEntry = std::pair<SDL_Scancode, keyInfo>;
-using hires_clock = std::chrono::high_resolution_clock;
-
-const int C8_WIDTH = 64;
-const int C8_HEIGHT = 32;
-const double SIXTY_HZ_MS = 16.67;
-const double TICK_SPEED_MS = (1.0 / 1000.0) * 1000;
-
 class Emulator {
 public:
 	// Initialize System
@@ -43,14 +33,11 @@ public:
 	void readROM(const std::string& PathToROM);
 
 	// Handle Timers
-	// Call execute()
+	// Call execute() for every instruction that is due
 	// Handle waiting for input (non-blocking)
+	// Drops presents (never instructions) when the host falls behind
 	void tick();
 
-	// OPCODE Decision Tree
-	// Fetch and Execute One (1) Instruction
-	void execute();
-
 	// Begin emulation
 	void run();
 
@@ -58,19 +45,45 @@ public:
 	// different things for the bitwise instructions (Resetting VF). 
 	// This method turns that quirk on or off.
 	// https://chip8.gulrak.net/#quirk5
-	void setBitwiseQuirk(bool setting) { resetVF = setting; }
+	void setBitwiseQuirk(bool setting) { core.setBitwiseQuirk(setting); }
 
 	// Some CHIP-8 programs or interpreters do slightly
 	// different things for the shift instructions (using VY). 
 	// This method turns that quirk on or off.
 	// https://chip8.gulrak.net/#quirk6
-	void setShiftQuirk(bool setting) { shiftVY = setting; }
+	void setShiftQuirk(bool setting) { core.setShiftQuirk(setting); }
 
 	// If this value is set to true, the screen will only update
 	// on calls to DXYN (draw sprite) or 00E0 (clear).
 	// Otherwise, the screen will update at a rate of 60 frames per second.
 	void setDrawOnCall(bool setting) { drawOnCall = setting; }
 
+	// Run at the speed of the original COSMAC VIP interpreter instead of a
+	// fixed number of instructions per frame. Best paired with the display
+	// wait quirk, which the VIP also had.
+	void setTimingModel(TimingModel model) { timing = model; }
+
+	// If this value is set to true, DXYN waits for the next frame
+	// (the display interrupt) before the machine carries on.
+	void setDisplayWaitQuirk(bool setting) { core.setDisplayWaitQuirk(setting); }
+
+	// What to do when the ROM hits an unknown instruction or breaks the stack:
+	// halt the machine (default), skip the instruction, or trap into an
+	// attached debugger (halting instead when none is attached). Whether
+	// one is attached is checked here, once, not on every fault.
+	// Faults are always logged, never prompted for.
+	void setFaultPolicy(FaultPolicy policy);
+
+	// Low latency mode runs a whole frame at a time: input is polled
+	// right before each frame's instructions and the screen presented
+	// right after them. F2 toggles it while running. Input latency for
+	// each mode is printed at shutdown.
+	void setLowLatencyMode(bool setting);
+
+	// Frame pacing metrics: frames run, presents skipped or coalesced
+	// while catching up, and how far behind real time the guest is.
+	const PacingStats& pacingStats() const { return pacer.stats; }
+
 
 private:
 	/* SDL */
@@ -79,148 +92,35 @@ private:
 	SDL_Event listener;
 	bool running;
 
-	/* Quirk Toggles */
-	bool shiftVY;
-	bool resetVF;
-	bool incrementOnlyByX;
-	bool incrementNone;
-
 	/* Emulator Values */
 	float tickSpeed = 1000.0f;
 	float frameRate = 60.0f;
-	std::chrono::time_point<hires_clock> lastFrame;
-	std::chrono::time_point<hires_clock> lastTick;
-	uint8_t waitingRegister = 0;
-	bool waitingForKey = false;
+	FramePacer pacer;
+	int frameSlot = 0; // Instructions run so far in the current frame
 	bool drawOnCall = false;
+	TimingModel timing = TimingModel::Fixed;
+	FaultPolicy faultPolicy = FaultPolicy::Halt;
+	bool debuggerPresent = false; // As of the last setFaultPolicy(Break)
+	AsyncLogger logger;
+
+	/* Input Latency */
+	bool lowLatency = false;
+	LatencyTracker latency;
+	uint32_t seenKeyReads = 0;
+	uint32_t seenDraws = 0;
 
 	/* Emulated Hardware */
-	stack<uint16_t> Stack;
-	map<SDL_Scancode, keyInfo> keyMap;
-	uint16_t PC;
-	uint16_t I;
-	uint8_t RAM[4096];
-	uint8_t V[16];
-	uint8_t screen[32][64];
-	uint8_t delayTimer;
-	uint8_t soundTimer;
+	Chip8 core;
 
 
 	/* Helper Functions */
 	void pollEvents();
+	void step();
+	void runFrames(int due, PacingLevel level);
+	void reportStatus(Chip8Status status);
+	void trackLatency();
+	void present();
 	void swapBuffers() const;
-	bool isValidKey(SDL_Scancode& key) const;
-	uint8_t getBit(uint8_t number, uint8_t place) const;
-	uint16_t sprite_addr(uint8_t hex) const;
-
-	////////////////////////////////
-	/*	        OPCODES          */
-	//////////////////////////////
-
-	// 0NNN
-	void callFunc(uint16_t NNN);
-
-	// 00E0
-	void clearDisplay();
-
-	// 00EE
-	void returnFunc();
-
-	// 1NNN
-	void jump(uint16_t NNN);
-
-	// 2NNN
-	void callFuncAt(uint16_t NNN);
-
-	// 3XNN
-	void skipEq(uint16_t X, uint16_t NN);
-
-	// 4XNN
-	void skipNeq(uint16_t X, uint16_t NN);
-
-	// 5XY0
-	void skipRegEq(uint16_t X, uint16_t Y);
-	
-	// 6XNN
-	void setRegX(uint16_t X, uint16_t NN); 
-
-	// 7XNN 
-	void addRegX(uint16_t X, uint16_t NN);
-
-	// 8XY0
-	void setRegXY(uint16_t X, uint16_t Y);
-
-	// 8XY1
-	void regOr(uint16_t X, uint16_t Y);
-
-	// 8XY2
-	void regAnd(uint16_t X, uint16_t Y);
-
-	// 8XY3
-	void regXor(uint16_t X, uint16_t Y);
-
-	// 8XY4 
-	void addRegXY(uint16_t X, uint16_t Y);
-
-	// 8XY5
-	void subRegXY(uint16_t X, uint16_t Y);
-
-	// 8XY6
-	void shrRegXY(uint16_t X, uint16_t Y);
-
-	// 8XY7 
-	void subRegYX(uint16_t X, uint16_t Y);
-
-	// 8XYE
-	void shlRegXY(uint16_t X, uint16_t Y);
-
-	// 9XY0
-	void skipRegNeq(uint16_t X, uint16_t Y); 
-
-	// ANNN
-	void setI(uint16_t NNN);
-
-	// BNNN
-	void jumpPlus(uint16_t NNN);
-
-	// CXNN
-	void setXRand(uint16_t X, uint16_t NN);
-
-	// DXYN
-	void draw(uint16_t X, uint16_t Y, uint16_t N);
-
-	// EX9E
-	void skipKeyEq(uint16_t X);
-
-	// EXA1
-	void skipKeyNeq(uint16_t X);
-
-	// FX07
-	void setXDelay(uint16_t X);
-
-	// FX0A
-	void waitForKey(uint16_t X);
-
-	// FX15
-	void setDelayX(uint16_t X);
-
-	// FX18
-	void setSoundX(uint16_t X);
-
-	// FX1E
-	void addXI(uint16_t X);
-
-	// FX29
-	void setISprite(uint16_t X);
-
-	// FX33
-	void setIBCD(uint16_t X);
-
-	// FX55
-	void regDump(uint16_t X);
-
-	// FX65
-	void regLoad(uint16_t X);
 };
 
-#endif
\ No newline at end of file
+#endif
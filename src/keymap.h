@@ -0,0 +1,42 @@
+/*
+	File:		keymap.h
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+#pragma once
+#ifndef KEYMAP_H
+#define KEYMAP_H
+
+#include "SDL3/SDL.h"
+
+/*
+	Key Map Layout
+	1 2 3 4
+	q w e r
+	a s d f
+	z x c v
+*/
+// Returns the CHIP-8 key for a scancode, or -1 if it is not mapped.
+inline int keypadIndex(SDL_Scancode scancode) {
+	switch (scancode) {
+	case SDL_SCANCODE_1: return 0;
+	case SDL_SCANCODE_2: return 1;
+	case SDL_SCANCODE_3: return 2;
+	case SDL_SCANCODE_4: return 3;
+	case SDL_SCANCODE_Q: return 4;
+	case SDL_SCANCODE_W: return 5;
+	case SDL_SCANCODE_E: return 6;
+	case SDL_SCANCODE_R: return 7;
+	case SDL_SCANCODE_A: return 8;
+	case SDL_SCANCODE_S: return 9;
+	case SDL_SCANCODE_D: return 10;
+	case SDL_SCANCODE_F: return 11;
+	case SDL_SCANCODE_Z: return 12;
+	case SDL_SCANCODE_X: return 13;
+	case SDL_SCANCODE_C: return 14;
+	case SDL_SCANCODE_V: return 15;
+	default: return -1;
+	}
+}
+
+#endif
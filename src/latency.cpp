@@ -0,0 +1,125 @@
+/*
+	File:		latency.cpp
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+
+#include <iomanip>
+#include <ostream>
+#include "latency.h"
+
+static const char* const STAGE_NAMES[] = { "input -> read", "read -> draw", "draw -> present", "input -> present" };
+static const char* const MODE_NAMES[] = { "Normal mode", "Low latency mode" };
+
+void LatencyHistogram::add(uint64_t ns) {
+	uint64_t us = ns / 1000;
+	int bucket = 0;
+	while (us > 1 && bucket < BUCKETS - 1) {
+		us >>= 1;
+		bucket++;
+	}
+	buckets[bucket]++;
+	samples++;
+	totalNs += ns;
+	if (ns > maxNs)
+		maxNs = ns;
+}
+
+uint64_t LatencyHistogram::percentileUs(double fraction) const {
+	uint64_t wanted = static_cast<uint64_t>(samples * fraction + 0.5);
+	uint64_t seen = 0;
+	for (int b = 0; b < BUCKETS; b++) {
+		seen += buckets[b];
+		if (seen >= wanted && seen > 0)
+			return 1ull << (b + 1);
+	}
+	return 1ull << BUCKETS;
+}
+
+void LatencyHistogram::print(std::ostream& out) const {
+	for (int b = 0; b < BUCKETS; b++) {
+		if (buckets[b] == 0)
+			continue;
+		out << "      < " << std::setw(8) << (1ull << (b + 1)) << "us " << std::setw(6) << buckets[b] << "\n";
+	}
+}
+
+void LatencyTracker::setLowLatency(bool setting) {
+	mode = setting ? 1 : 0;
+	if (stage != LatencyStage::Count && sampleMode != mode) { // Started under the other mode
+		abandoned[sampleMode]++;
+		stage = LatencyStage::Count;
+	}
+}
+
+void LatencyTracker::inputArrived(uint64_t eventNs) {
+	if (stage != LatencyStage::Count && !expired(eventNs))
+		return;
+	stage = LatencyStage::InputToRead;
+	sampleMode = mode;
+	inputNs = eventNs;
+}
+
+// Drop the sample in flight if it has gone stale by 'ns'.
+bool LatencyTracker::expired(uint64_t ns) {
+	if (ns < inputNs || ns - inputNs <= STALE_NS)
+		return false;
+	abandoned[sampleMode]++;
+	stage = LatencyStage::Count;
+	return true;
+}
+
+void LatencyTracker::keyRead(uint64_t ns) {
+	if (!waitingForRead() || expired(ns))
+		return;
+	readNs = ns;
+	stage = LatencyStage::ReadToDraw;
+}
+
+void LatencyTracker::drew(uint64_t ns) {
+	if (!waitingForDraw() || expired(ns))
+		return;
+	drawNs = ns;
+	stage = LatencyStage::DrawToPresent;
+}
+
+void LatencyTracker::presented(uint64_t ns) {
+	if (!waitingForPresent() || expired(ns))
+		return;
+	record(LatencyStage::InputToRead, inputNs, readNs);
+	record(LatencyStage::ReadToDraw, readNs, drawNs);
+	record(LatencyStage::DrawToPresent, drawNs, ns);
+	record(LatencyStage::Total, inputNs, ns);
+	stage = LatencyStage::Count;
+}
+
+void LatencyTracker::record(LatencyStage which, uint64_t from, uint64_t to) {
+	histograms[sampleMode][static_cast<int>(which)].add(to > from ? to - from : 0);
+}
+
+void LatencyTracker::report(std::ostream& out) const {
+	const int total = static_cast<int>(LatencyStage::Total);
+	out << std::fixed << std::setprecision(2);
+	for (int m = 0; m < 2; m++) {
+		if (histograms[m][total].count() == 0)
+			continue;
+		out << MODE_NAMES[m] << " input latency (" << histograms[m][total].count()
+			<< " samples, " << abandoned[m] << " abandoned):\n";
+		for (int s = 0; s < static_cast<int>(LatencyStage::Count); s++) {
+			const LatencyHistogram& h = histograms[m][s];
+			out << "  " << std::left << std::setw(17) << STAGE_NAMES[s] << std::right
+				<< " mean " << h.meanUs() / 1000.0 << "ms, p50 < " << h.percentileUs(0.5) / 1000.0
+				<< "ms, p99 < " << h.percentileUs(0.99) / 1000.0 << "ms, max " << h.maxUs() / 1000.0 << "ms\n";
+		}
+		histograms[m][total].print(out);
+	}
+
+	const LatencyHistogram& normal = histograms[0][total];
+	const LatencyHistogram& low = histograms[1][total];
+	if (normal.count() > 0 && low.count() > 0) {
+		out << "Low latency mode changed mean input -> present latency by "
+			<< (low.meanUs() - normal.meanUs()) / 1000.0 << "ms ("
+			<< normal.meanUs() / 1000.0 << "ms -> " << low.meanUs() / 1000.0 << "ms)\n";
+	}
+	out << std::defaultfloat;
+}
@@ -0,0 +1,89 @@
+/*
+	File:		latency.h
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+#pragma once
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <cstdint>
+#include <ostream>
+
+// Log2 histogram of durations. Bucket b counts samples of
+// [2^b, 2^(b+1)) microseconds (bucket 0 also takes anything under 1us).
+class LatencyHistogram {
+public:
+	static const int BUCKETS = 24; // Up to ~16 seconds
+
+	void add(uint64_t ns);
+
+	uint64_t count() const { return samples; }
+	double meanUs() const { return samples ? totalNs / 1000.0 / samples : 0.0; }
+	double maxUs() const { return maxNs / 1000.0; }
+
+	// Upper edge of the bucket holding the given fraction of samples.
+	uint64_t percentileUs(double fraction) const;
+
+	void print(std::ostream& out) const;
+
+private:
+	uint64_t buckets[BUCKETS] = {};
+	uint64_t samples = 0;
+	uint64_t totalNs = 0;
+	uint64_t maxNs = 0;
+};
+
+enum class LatencyStage : uint8_t {
+	InputToRead,	// Key event to the first EX9E/EXA1/FX0A after it
+	ReadToDraw,		// That read to the next DXYN
+	DrawToPresent,	// That DXYN to the present that shows it
+	Total,			// Key event to present
+	Count
+};
+
+// Follows one key event at a time through the machine: until that input
+// has been read, drawn and presented, later events are not timed. All
+// times are SDL_GetTicksNS() nanoseconds, the clock SDL stamps events with.
+// Samples are kept apart for normal and low latency mode so one run can
+// compare the two. The caller stamps at batch granularity, so stages that
+// land in the same batch measure as zero.
+class LatencyTracker {
+public:
+	// A sample not finished within this long is thrown away (the ROM
+	// ignored that key, or the read did not lead to a draw).
+	static const uint64_t STALE_NS = 250ull * 1000 * 1000;
+
+	void setLowLatency(bool setting);
+
+	// A keypad key went down or up at 'eventNs'.
+	void inputArrived(uint64_t eventNs);
+
+	bool waitingForRead() const { return stage == LatencyStage::InputToRead; }
+	bool waitingForDraw() const { return stage == LatencyStage::ReadToDraw; }
+	bool waitingForPresent() const { return stage == LatencyStage::DrawToPresent; }
+
+	void keyRead(uint64_t ns);
+	void drew(uint64_t ns);
+	void presented(uint64_t ns);
+
+	// Per stage summaries for each mode that has samples, then the
+	// change in end to end latency if both do.
+	void report(std::ostream& out) const;
+
+private:
+	LatencyHistogram histograms[2][static_cast<int>(LatencyStage::Count)];
+	uint64_t abandoned[2] = {};
+	int mode = 0; // 1 in low latency mode
+
+	LatencyStage stage = LatencyStage::Count; // Count: nothing in flight
+	int sampleMode = 0;
+	uint64_t inputNs = 0;
+	uint64_t readNs = 0;
+	uint64_t drawNs = 0;
+
+	bool expired(uint64_t ns);
+	void record(LatencyStage which, uint64_t from, uint64_t to);
+};
+
+#endif
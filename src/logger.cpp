@@ -0,0 +1,109 @@
+/*
+	File:		logger.cpp
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include "logger.h"
+
+using steady = std::chrono::steady_clock;
+
+const auto DRAIN_INTERVAL = std::chrono::milliseconds(10);
+
+AsyncLogger::AsyncLogger() : head(0), tail(0), dropped(0), stopping(false) {
+	windowStart = steady::now();
+	for (int k = 0; k < KIND_COUNT; k++) {
+		budget[k].store(MESSAGES_PER_SECOND, std::memory_order_relaxed);
+		suppressed[k].store(0, std::memory_order_relaxed);
+	}
+	writer = std::thread(&AsyncLogger::writerLoop, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+	stopping.store(true, std::memory_order_release);
+	writer.join();
+}
+
+bool AsyncLogger::post(const Chip8Fault& fault) {
+	return push(static_cast<int>(fault.status), Entry{ fault, nullptr });
+}
+
+bool AsyncLogger::post(const char* text) {
+	return push(NOTICE_KIND, Entry{ Chip8Fault{}, text });
+}
+
+bool AsyncLogger::push(int kind, const Entry& entry) {
+	if (budget[kind].load(std::memory_order_relaxed) <= 0) {
+		suppressed[kind].fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	budget[kind].fetch_sub(1, std::memory_order_relaxed);
+
+	uint32_t h = head.load(std::memory_order_relaxed);
+	if (h - tail.load(std::memory_order_acquire) == CAPACITY) {
+		dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	ring[h & (CAPACITY - 1)] = entry;
+	head.store(h + 1, std::memory_order_release);
+	return true;
+}
+
+static const char* faultName(Chip8Status status) {
+	switch (status) {
+	case Chip8Status::IgnoredCall:		return "INSTRUCTION IGNORED: 0NNN";
+	case Chip8Status::StackUnderflow:	return "STACK EMPTY. OPCODE 00EE (returnFunc)";
+	case Chip8Status::StackOverflow:	return "STACK FULL. OPCODE 2NNN (callFuncAt)";
+	case Chip8Status::UnknownOpcode:	return "Unknown instruction";
+	default:							return "Emulator halted";
+	}
+}
+
+static void printFault(const Chip8Fault& fault) {
+	std::cout << faultName(fault.status) << std::hex << std::uppercase << std::setfill('0')
+		<< " [" << std::setw(4) << fault.opcode << " at " << std::setw(3) << fault.PC << "]\n"
+		<< std::dec << std::nouppercase << std::setfill(' ');
+}
+
+void AsyncLogger::writerLoop() {
+	while (!stopping.load(std::memory_order_acquire)) {
+		drain();
+		std::this_thread::sleep_for(DRAIN_INTERVAL);
+	}
+	drain();
+}
+
+// Print what is queued. Once a second, report what was
+// rate limited and refill every kind's budget.
+void AsyncLogger::drain() {
+	uint32_t t = tail.load(std::memory_order_relaxed);
+	uint32_t h = head.load(std::memory_order_acquire);
+	for (; t != h; t++) {
+		const Entry& entry = ring[t & (CAPACITY - 1)];
+		if (entry.notice)
+			std::cout << entry.notice << "\n";
+		else
+			printFault(entry.fault);
+	}
+	tail.store(t, std::memory_order_release);
+
+	auto now = steady::now();
+	if (now - windowStart >= std::chrono::seconds(1) || stopping.load(std::memory_order_acquire)) {
+		for (int k = 0; k < KIND_COUNT; k++) {
+			uint32_t count = suppressed[k].exchange(0, std::memory_order_relaxed);
+			if (count > 0 && k == NOTICE_KIND)
+				std::cout << "... " << count << " more notices suppressed\n";
+			else if (count > 0)
+				std::cout << "... " << count << " more \"" << faultName(static_cast<Chip8Status>(k)) << "\" suppressed\n";
+			budget[k].store(MESSAGES_PER_SECOND, std::memory_order_relaxed);
+		}
+		uint32_t lost = dropped.exchange(0, std::memory_order_relaxed);
+		if (lost > 0)
+			std::cout << "... " << lost << " messages dropped (log queue full)\n";
+		windowStart = now;
+	}
+	std::cout.flush();
+}
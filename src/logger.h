@@ -0,0 +1,63 @@
+/*
+	File:		logger.h
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+#pragma once
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "chip8.h"
+
+// Prints machine faults and emulator notices from a background thread.
+// post() is lock-free and allocation-free: it copies the fault into a
+// fixed ring and returns. Each kind of fault gets MESSAGES_PER_SECOND
+// messages per second. Past that, post() only counts, and the writer
+// thread prints a summary, so a ROM that faults in a loop can neither
+// flood the console nor crowd out other faults. One producer thread only.
+class AsyncLogger {
+public:
+	static const int CAPACITY = 1024; // Power of two
+	static const int MESSAGES_PER_SECOND = 5;
+
+	AsyncLogger();
+	~AsyncLogger();
+
+	// Returns false if the message was rate limited or the ring is full.
+	bool post(const Chip8Fault& fault);
+
+	// Queue a fixed line of text. Only the pointer is copied, so 'text'
+	// must live as long as the logger (e.g. a string literal). Notices
+	// share one budget, kept apart from the faults'.
+	bool post(const char* text);
+
+private:
+	static const int FAULT_KINDS = static_cast<int>(Chip8Status::UnknownOpcode) + 1;
+	static const int NOTICE_KIND = FAULT_KINDS;
+	static const int KIND_COUNT = FAULT_KINDS + 1;
+
+	struct Entry {
+		Chip8Fault fault;
+		const char* notice; // Printed instead of the fault when set
+	};
+
+	Entry ring[CAPACITY];
+	alignas(64) std::atomic<uint32_t> head; // Next slot to write (producer)
+	alignas(64) std::atomic<uint32_t> tail; // Next slot to read (writer thread)
+	alignas(64) std::atomic<int> budget[KIND_COUNT]; // Refilled every second by the writer
+	std::atomic<uint32_t> suppressed[KIND_COUNT];
+	std::atomic<uint32_t> dropped;
+	std::atomic<bool> stopping;
+	std::thread writer;
+	std::chrono::steady_clock::time_point windowStart; // Writer thread only
+
+	bool push(int kind, const Entry& entry);
+	void writerLoop();
+	void drain();
+};
+
+#endif
@@ -17,13 +17,28 @@
 #include <string>
 #include "SDL3/SDL.h"
 #include "emulator.h"
+#include "wall.h"
 
 using std::string;
 
 // Path to ROM Here
 const string pathToROM = "Path-To-Rom-Here";
 
+// Set above 1 to run that many copies of the ROM side by side in one window.
+const int wallSessions = 1;
+
 int main() {
+	if (wallSessions > 1) {
+		Wall wall(wallSessions);
+		for (int i = 0; i < wallSessions; i++) {
+			Chip8& session = wall.addSession(pathToROM);
+			session.setShiftQuirk(true);
+			session.setBitwiseQuirk(true);
+		}
+		wall.run();
+		return 0;
+	}
+
 	Emulator emu;
 	emu.readROM(pathToROM);
 	emu.setShiftQuirk(true);
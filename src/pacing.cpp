@@ -0,0 +1,62 @@
+/*
+	File:		pacing.cpp
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+
+#include "chip8.h"
+#include "pacing.h"
+
+const double SLOT_MS = SIXTY_HZ_MS / C8_INSTRUCTIONS_PER_FRAME;
+const double LAG_SMOOTHING = 0.1;
+
+// Escalate once the smoothed lag passes these, drop back below half of them.
+const double SKIP_FRAMES_LAG_MS = SIXTY_HZ_MS;
+const double COALESCE_LAG_MS = SIXTY_HZ_MS * 3;
+
+void FramePacer::start(clock::time_point now) {
+	origin = now;
+	issued = 0;
+	stats = PacingStats();
+}
+
+int FramePacer::instructionsDue(clock::time_point now) {
+	std::chrono::duration<double, std::milli> elapsed = now - origin;
+	uint64_t owed = static_cast<uint64_t>(elapsed.count() / SLOT_MS);
+	if (owed <= issued)
+		return 0;
+
+	// After a stall (window drag, sleep...) give up the old debt
+	// instead of fast forwarding through it.
+	uint64_t due = owed - issued;
+	const uint64_t maxDue = static_cast<uint64_t>(MAX_CATCH_UP_FRAMES) * C8_INSTRUCTIONS_PER_FRAME;
+	if (due > maxDue) {
+		stats.droppedFrames += (due - maxDue) / C8_INSTRUCTIONS_PER_FRAME;
+		issued = owed - maxDue;
+		due = maxDue;
+	}
+	issued += due;
+
+	double lag = (due - 1) * SLOT_MS;
+	stats.lagMs += (lag - stats.lagMs) * LAG_SMOOTHING;
+	if (stats.lagMs > stats.maxLagMs)
+		stats.maxLagMs = stats.lagMs;
+
+	switch (stats.level) {
+	case PacingLevel::Normal:
+		if (stats.lagMs >= SKIP_FRAMES_LAG_MS)
+			stats.level = PacingLevel::SkipFrames;
+		break;
+	case PacingLevel::SkipFrames:
+		if (stats.lagMs >= COALESCE_LAG_MS)
+			stats.level = PacingLevel::Coalesce;
+		else if (stats.lagMs < SKIP_FRAMES_LAG_MS / 2)
+			stats.level = PacingLevel::Normal;
+		break;
+	case PacingLevel::Coalesce:
+		if (stats.lagMs < COALESCE_LAG_MS / 2)
+			stats.level = PacingLevel::SkipFrames;
+		break;
+	}
+	return static_cast<int>(due);
+}
@@ -0,0 +1,61 @@
+/*
+	File:		pacing.h
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+#pragma once
+#ifndef PACING_H
+#define PACING_H
+
+#include <chrono>
+#include <cstdint>
+
+// How much presentation work is being shed to keep up with real time.
+enum class PacingLevel : uint8_t {
+	Normal,		// On time: present everything
+	SkipFrames,	// Behind: only the last frame of a catch up burst is presented
+	Coalesce	// Far behind: also merge every DXYN/00E0 present in a burst into one
+};
+
+struct PacingStats {
+	uint64_t framesRun = 0;			// Guest frames (timer ticks) emulated
+	uint64_t presents = 0;
+	uint64_t skippedPresents = 0;	// Frame presents dropped by SkipFrames
+	uint64_t coalescedPresents = 0;	// Draw presents merged by Coalesce
+	uint64_t unchangedPresents = 0;	// Presents skipped because the screen looked the same
+	uint64_t droppedFrames = 0;		// Guest frames given up after a very long stall
+	double lagMs = 0.0;				// Smoothed time the guest is behind the host
+	double maxLagMs = 0.0;
+	PacingLevel level = PacingLevel::Normal;
+};
+
+// Keeps the guest on a fixed clock of C8_INSTRUCTIONS_PER_FRAME
+// instructions per 60Hz frame, measured against the host clock.
+// Instructions and timer ticks are never skipped (short of a stall
+// longer than MAX_CATCH_UP_FRAMES). When the host falls behind, the
+// caller runs the whole backlog at once and uses level() to decide
+// which presents it can drop.
+class FramePacer {
+public:
+	static const int MAX_CATCH_UP_FRAMES = 15;
+
+	using clock = std::chrono::steady_clock;
+
+	// Start the guest clock at 'now'.
+	void start(clock::time_point now);
+
+	// How many instruction slots are owed at 'now'. Claims them,
+	// so the next call only returns newly due slots. Also updates
+	// the lag measurement and the shedding level.
+	int instructionsDue(clock::time_point now);
+
+	PacingLevel level() const { return stats.level; }
+
+	PacingStats stats;
+
+private:
+	clock::time_point origin;
+	uint64_t issued = 0;
+};
+
+#endif
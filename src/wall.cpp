@@ -0,0 +1,243 @@
+/*
+	File:		wall.cpp
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "SDL3/SDL.h"
+#include "keymap.h"
+#include "wall.h"
+
+const uint32_t PIXEL_ON = 0xFFFFFFFF;
+const uint32_t PIXEL_OFF = 0xFF000000;
+const int TILE_SCALE = 4;
+const Uint64 FRAME_NS = static_cast<Uint64>(SIXTY_HZ_MS * 1000000.0);
+
+// Every session takes all of its pages when it is created. Pages
+// nobody writes to are reserved but never touched, so they cost no memory.
+static int arenaPages(int sessionCount) {
+	if (sessionCount < 1)
+		throw std::runtime_error("A wall needs at least one session.");
+	if (sessionCount > Chip8PageArena::MAX_MACHINES)
+		throw std::runtime_error("A wall holds at most " + std::to_string(Chip8PageArena::MAX_MACHINES) + " sessions.");
+	return sessionCount * C8_PAGE_COUNT;
+}
+
+Wall::Wall(int sessionCount) : pageArena(arenaPages(sessionCount)) {
+	capacity = sessionCount;
+	columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(capacity))));
+	rows = (capacity + columns - 1) / columns;
+	int atlasWidth = columns * C8_WIDTH;
+	int atlasHeight = rows * C8_HEIGHT;
+
+	// Init SDL
+	SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+	window = SDL_CreateWindow("CHIP-8 Wall", atlasWidth * TILE_SCALE, atlasHeight * TILE_SCALE, SDL_WINDOW_RESIZABLE);
+	renderer = SDL_CreateRenderer(window, NULL);
+	SDL_SetRenderLogicalPresentation(renderer, atlasWidth, atlasHeight, SDL_LOGICAL_PRESENTATION_INTEGER_SCALE);
+	atlas = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, atlasWidth, atlasHeight);
+	SDL_SetTextureScaleMode(atlas, SDL_SCALEMODE_NEAREST);
+	running = false;
+	listener = SDL_Event();
+
+	sessions.reserve(capacity);
+	statuses.reserve(capacity);
+	nextSession = 0;
+
+	// Leave one core for the render thread.
+	unsigned int threads = std::thread::hardware_concurrency();
+	threads = threads > 1 ? threads - 1 : 1;
+	for (unsigned int i = 0; i < threads; i++)
+		workers.emplace_back(&Wall::workerLoop, this);
+}
+
+Wall::~Wall() {
+	{
+		std::lock_guard<std::mutex> lock(poolMutex);
+		stopping = true;
+	}
+	frameStart.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+	SDL_DestroyTexture(atlas);
+	SDL_DestroyRenderer(renderer);
+	SDL_DestroyWindow(window);
+}
+
+Chip8& Wall::addSession(const std::string& PathToROM) {
+	if (static_cast<int>(sessions.size()) >= capacity)
+		throw std::runtime_error("The wall is full.");
+	std::shared_ptr<const Chip8Image>& image = images[PathToROM];
+	if (!image) {
+		std::vector<uint8_t> rom = readROMFile(PathToROM);
+		image = makeROMImage(rom.data(), rom.size());
+	}
+	sessions.emplace_back(pageArena);
+	statuses.push_back(Chip8Status::Ok);
+	sessions.back().loadImage(image);
+	return sessions.back();
+}
+
+void Wall::run() {
+	if (sessions.empty())
+		return;
+	running = true;
+	setFocus(0);
+	Uint64 nextFrame = SDL_GetTicksNS();
+	while (running) {
+		pollEvents();
+		runFrame();
+
+		for (size_t i = 0; i < sessions.size(); i++) {
+			if (statuses[i] != Chip8Status::Ok && statuses[i] != Chip8Status::Halted)
+				logger.post(sessions[i].lastFault());
+		}
+
+		// Keep a steady 60Hz. If the host fell far behind, start over
+		// from now rather than running a burst of catch up frames.
+		nextFrame += FRAME_NS;
+		Uint64 now = SDL_GetTicksNS();
+		if (now < nextFrame)
+			SDL_DelayNS(nextFrame - now);
+		else if (now - nextFrame > FRAME_NS * 4)
+			nextFrame = now;
+	}
+
+	size_t resident = 0;
+	int privatePages = 0;
+	for (const Chip8& session : sessions) {
+		resident += session.residentBytes();
+		privatePages += session.privatePageCount();
+	}
+	std::cout << "Wall shutting down..." << "\n"
+		<< sessions.size() << " sessions, " << images.size() << " ROM images, "
+		<< privatePages << " private pages, " << resident / sessions.size() << " bytes per session" << std::endl;
+}
+
+// Run one frame of every session and show the result.
+void Wall::runFrame() {
+	void* locked = nullptr;
+	if (!SDL_LockTexture(atlas, NULL, &locked, &pitch))
+		return;
+	pixels = static_cast<uint32_t*>(locked);
+
+	runSessions();
+
+	SDL_UnlockTexture(atlas);
+	pixels = nullptr;
+
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+	SDL_RenderClear(renderer);
+	SDL_RenderTexture(renderer, atlas, NULL, NULL);
+
+	// Outline the tile that receives input.
+	const SDL_FRect outline = {
+		static_cast<float>((focused % columns) * C8_WIDTH),
+		static_cast<float>((focused / columns) * C8_HEIGHT),
+		static_cast<float>(C8_WIDTH), static_cast<float>(C8_HEIGHT) };
+	SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+	SDL_RenderRect(renderer, &outline);
+
+	SDL_RenderPresent(renderer);
+}
+
+// Hand the frame to the workers and wait for all of them.
+void Wall::runSessions() {
+	std::unique_lock<std::mutex> lock(poolMutex);
+	nextSession.store(0, std::memory_order_relaxed);
+	busyWorkers = static_cast<int>(workers.size());
+	generation++;
+	frameStart.notify_all();
+	frameDone.wait(lock, [this] { return busyWorkers == 0; });
+}
+
+void Wall::workerLoop() {
+	uint64_t seen = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(poolMutex);
+			frameStart.wait(lock, [&] { return stopping || generation != seen; });
+			if (stopping)
+				return;
+			seen = generation;
+		}
+
+		// Sessions are claimed one at a time, so a slow one
+		// never holds up a whole block of others.
+		int count = static_cast<int>(sessions.size());
+		for (int i = nextSession.fetch_add(1); i < count; i = nextSession.fetch_add(1)) {
+			statuses[i] = sessions[i].runFrame(C8_INSTRUCTIONS_PER_FRAME);
+			drawTile(i);
+		}
+
+		std::lock_guard<std::mutex> lock(poolMutex);
+		if (--busyWorkers == 0)
+			frameDone.notify_one();
+	}
+}
+
+// Expand one session's screen into its tile of the locked atlas.
+// The locked memory is write-only, so every tile is redrawn every frame.
+void Wall::drawTile(int index) {
+	const Chip8State& state = sessions[index].state();
+	int tileX = (index % columns) * C8_WIDTH;
+	int tileY = (index / columns) * C8_HEIGHT;
+	for (int y = 0; y < C8_HEIGHT; y++) {
+		uint32_t* line = reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(pixels) + (tileY + y) * pitch) + tileX;
+		uint64_t bits = state.screen[y];
+		for (int x = 0; x < C8_WIDTH; x++)
+			line[x] = ((bits >> (63 - x)) & 1u) ? PIXEL_ON : PIXEL_OFF;
+	}
+}
+
+void Wall::setFocus(int index) {
+	if (sessions.empty())
+		return;
+	sessions[focused].setKeys(0); // Do not leave keys held on the old tile
+	focused = index;
+	std::string title = "CHIP-8 Wall - Session " + std::to_string(focused + 1) + " of " + std::to_string(sessions.size());
+	SDL_SetWindowTitle(window, title.c_str());
+}
+
+// Handles all input
+void Wall::pollEvents() {
+	int count = static_cast<int>(sessions.size());
+	while (SDL_PollEvent(&listener)) {
+		int key;
+		switch (listener.type) {
+			case SDL_EVENT_QUIT:
+				running = false;
+				break;
+			case SDL_EVENT_MOUSE_BUTTON_DOWN: {
+				float x, y;
+				SDL_RenderCoordinatesFromWindow(renderer, listener.button.x, listener.button.y, &x, &y);
+				int column = static_cast<int>(x) / C8_WIDTH;
+				int row = static_cast<int>(y) / C8_HEIGHT;
+				int index = row * columns + column;
+				if (x >= 0 && y >= 0 && column < columns && index < count)
+					setFocus(index);
+				break;
+			}
+			case SDL_EVENT_KEY_UP:
+				key = keypadIndex(listener.key.scancode);
+				if (key >= 0)
+					sessions[focused].releaseKey(key); // Also completes FX0A
+				break;
+			case SDL_EVENT_KEY_DOWN:
+				if (listener.key.scancode == SDL_SCANCODE_TAB && !listener.key.repeat) {
+					bool back = (listener.key.mod & SDL_KMOD_SHIFT) != 0;
+					setFocus((focused + (back ? count - 1 : 1)) % count);
+					break;
+				}
+				key = keypadIndex(listener.key.scancode);
+				if (key >= 0)
+					sessions[focused].pressKey(key);
+				break;
+		}
+	}
+}
@@ -0,0 +1,84 @@
+/*
+	File:		wall.h
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+*/
+#pragma once
+#ifndef WALL_H
+#define WALL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SDL3/SDL.h"
+#include "chip8.h"
+#include "logger.h"
+
+// Runs many machines side by side in one window.
+// Every session is a tile of a single streaming texture, so a
+// display refresh is one texture upload, one copy and one present
+// no matter how many sessions there are. Frames are run on a pool
+// of worker threads. Keyboard input goes to the focused tile
+// (click a tile, or Tab / Shift+Tab to move focus).
+class Wall {
+public:
+	// Open a window with room for 'sessionCount' tiles.
+	explicit Wall(int sessionCount);
+	~Wall();
+
+	// Start a new session running the given ROM and return its
+	// machine so quirks can be set. Throws once the wall is full.
+	// Sessions of the same ROM share one copy of it.
+	Chip8& addSession(const std::string& PathToROM);
+
+	// Begin emulation
+	void run();
+
+private:
+	/* SDL */
+	SDL_Renderer* renderer;
+	SDL_Window* window;
+	SDL_Texture* atlas;
+	SDL_Event listener;
+	bool running;
+
+	/* Layout */
+	int capacity;
+	int columns;
+	int rows;
+	int focused = 0;
+
+	/* Sessions */
+	Chip8PageArena pageArena; // Outlives the sessions
+	std::vector<Chip8> sessions;
+	std::vector<Chip8Status> statuses;
+	std::map<std::string, std::shared_ptr<const Chip8Image>> images; // By path
+	AsyncLogger logger;
+
+	/* Worker Pool */
+	std::vector<std::thread> workers;
+	std::mutex poolMutex;
+	std::condition_variable frameStart;
+	std::condition_variable frameDone;
+	uint64_t generation = 0;
+	int busyWorkers = 0;
+	bool stopping = false;
+	std::atomic<int> nextSession;
+	uint32_t* pixels = nullptr; // Locked atlas, valid during a frame
+	int pitch = 0;
+
+	/* Helper Functions */
+	void pollEvents();
+	void runFrame();
+	void workerLoop();
+	void runSessions();
+	void drawTile(int index);
+	void setFocus(int index);
+};
+
+#endif
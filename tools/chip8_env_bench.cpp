@@ -0,0 +1,80 @@
+/*
+	File:		chip8_env_bench.cpp
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+
+	Runs a server and a client on this machine and reports environment
+	steps per second. The server is forked into its own process, so every
+	step crosses the same shared memory path a real agent would use.
+	Usage: chip8_env_bench <rom> [num-envs] [frames]
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "chip8_env.h"
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <rom> [num-envs] [frames]\n";
+		return 1;
+	}
+	uint32_t numEnvs = argc > 2 ? std::strtoul(argv[2], nullptr, 0) : 64;
+	uint32_t frames = argc > 3 ? std::strtoul(argv[3], nullptr, 0) : 10000;
+
+	std::ifstream inFile(argv[1], std::ios::binary);
+	if (!inFile.is_open()) {
+		std::cerr << "Unable to open ROM. Double check the file path.\n";
+		return 1;
+	}
+	std::vector<uint8_t> rom((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+
+	std::string name = "/chip8-env-bench-" + std::to_string(getpid());
+	chip8_env_config config = {};
+	config.numEnvs = numEnvs;
+	chip8_env_server* server = chip8_env_server_create(name.c_str(), &config, rom.data(), rom.size());
+	if (!server) {
+		std::cerr << "Unable to create shared memory region " << name << "\n";
+		return 1;
+	}
+
+	pid_t child = fork();
+	if (child == 0)
+		_exit(chip8_env_server_serve(server));
+
+	chip8_env_client* client = chip8_env_client_open(name.c_str());
+	if (!client) {
+		std::cerr << "Unable to open shared memory region " << name << "\n";
+		return 1;
+	}
+
+	uint16_t* actions = chip8_env_client_actions(client);
+	uint32_t halted = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (uint32_t f = 0; f < frames; f++) {
+		for (uint32_t e = 0; e < numEnvs; e++)
+			actions[e] = static_cast<uint16_t>(rand());
+		chip8_env_client_step(client);
+	}
+	auto end = std::chrono::steady_clock::now();
+	const chip8_env_obs* obs = chip8_env_client_observations(client);
+	for (uint32_t e = 0; e < numEnvs; e++)
+		halted += obs[e].halted;
+	chip8_env_client_shutdown(client);
+	chip8_env_client_close(client);
+	waitpid(child, nullptr, 0);
+	chip8_env_server_destroy(server);
+
+	double seconds = std::chrono::duration<double>(end - start).count();
+	double steps = double(frames) * numEnvs;
+	std::cout << numEnvs << " envs x " << frames << " frames in " << seconds << "s\n";
+	std::cout << steps / seconds << " environment steps per second ("
+		<< halted << " machines halted)\n";
+	return 0;
+}
@@ -0,0 +1,46 @@
+/*
+	File:		chip8_env_server.cpp
+	By:			Ethan Kigotho (https://github.com/rubriclake)
+	Date Made:	10/18/2026
+
+	Serves K machines over shared memory until a client asks it to shut down.
+	Usage: chip8_env_server <shm-name> <rom> <num-envs> [ram-tap ...]
+*/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "chip8_env.h"
+
+int main(int argc, char** argv) {
+	if (argc < 4) {
+		std::cerr << "Usage: " << argv[0] << " <shm-name> <rom> <num-envs> [ram-tap ...]\n";
+		return 1;
+	}
+
+	std::ifstream inFile(argv[2], std::ios::binary);
+	if (!inFile.is_open()) {
+		std::cerr << "Unable to open ROM. Double check the file path.\n";
+		return 1;
+	}
+	std::vector<uint8_t> rom((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+
+	chip8_env_config config = {};
+	config.numEnvs = std::strtoul(argv[3], nullptr, 0);
+	for (int i = 4; i < argc && config.numRamTaps < CHIP8_ENV_MAX_RAM_TAPS; i++)
+		config.ramTaps[config.numRamTaps++] = std::strtoul(argv[i], nullptr, 0);
+	config.bitwiseQuirk = 1;
+	config.shiftQuirk = 1;
+
+	chip8_env_server* server = chip8_env_server_create(argv[1], &config, rom.data(), rom.size());
+	if (!server) {
+		std::cerr << "Unable to create shared memory region " << argv[1] << "\n";
+		return 1;
+	}
+	std::cout << "Serving " << config.numEnvs << " machines on " << argv[1] << std::endl;
+	int result = chip8_env_server_serve(server);
+	chip8_env_server_destroy(server);
+	return result;
+}